@@ -1,2322 +1,8562 @@
-#define  _CRT_SECURE_NO_WARNINGS
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-// 病人信息结构
-struct Patient {
-    int patientID;      // 病人ID
-    char name[50];      // 姓名
-    int gender;         // 性别
-    char phone[20];     // 电话
-    char diagnosis[100]; // 诊断结果
-    int age;            // 年龄
-};
-
-enum BedType {
-    RegularBed = 0,     // 普通床位
-    ICUBed,             // 重症监护床位
-    EmergencyBed        // 急诊床位
-};
-
-struct Bed {
-    int ID;             // 床位ID
-    int isOccupied;     // 是否已分配
-    int hasOxygen;      // 是否有供氧设备
-    enum BedType bedType; // 床位类型
-    int ward;           // 病房号
-    int department;     // 科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他)
-    struct Patient patient; // 病人信息
-    struct Bed* next;   // 链表指针
-};
-
-// 医生结构体定义
-struct Doctor {
-    int doctorID;           // 医生ID
-    char name[50];          // 姓名
-    int gender;             // 性别（1-男，0-女）
-    char phone[20];         // 联系电话
-    int department;         // 所属科室（与床位科室编码一致：1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他）
-    char specialization[50]; // 专业/专长
-    int qualification;      // 职称（1-住院医师, 2-主治医师, 3-副主任医师, 4-主任医师）
-    char officeLocation[30]; // 办公室位置
-    struct Doctor* next;    // 链表指针
-};
-
-// 医生-病人关联结构体
-struct DoctorPatientRelation {
-    int doctorID;            // 医生ID
-    int patientID;           // 病人ID
-    char notes[100];         // 医疗备注
-    char startDate[20];      // 开始负责日期
-    struct DoctorPatientRelation* next; // 链表指针
-};
-
-// 医生-病房关联结构体
-struct DoctorWardRelation {
-    int doctorID;            // 医生ID
-    int wardNumber;          // 病房号
-    int isHeadDoctor;        // 是否为主治医生（1-是，0-否）
-    char scheduleInfo[100];  // 查房安排
-    struct DoctorWardRelation* next; // 链表指针
-};
-
-// 全局链表头指针
-struct Bed* head = NULL;
-struct Doctor* doctorHead = NULL;
-struct DoctorPatientRelation* doctorPatientHead = NULL;
-struct DoctorWardRelation* doctorWardHead = NULL;
-
-// 函数前向声明
-void listAllBeds();
-void listAvailableBeds();
-void listAvailableBedsLocal();
-
-// 医生管理函数声明
-void addDoctor();
-void modifyDoctor();
-void deleteDoctor();
-void searchDoctorByID();
-void listAllDoctors();
-void assignPatientToDoctor();
-void removePatientFromDoctor();
-void listPatientsByDoctor();
-void listDoctorsByPatient();
-void assignWardToDoctor();
-void removeWardFromDoctor();
-void listWardsByDoctor();
-void listDoctorsByWard();
-void loadDoctorsFromFile(const char* filename);
-void loadDoctorPatientFromFile(const char* filename);
-void loadDoctorWardFromFile(const char* filename);
-void saveDoctorsToFile(const char* filename);
-void saveDoctorPatientToFile(const char* filename);
-void saveDoctorWardToFile(const char* filename);
-
-// 打印分隔线
-void printSeparator() {
-    printf("\n");
-    printf("----------------------------------------------------------------\n");
-}
-
-// 打印操作标题
-void printOperationTitle(const char* title) {
-    printSeparator();
-    printf("【%s】\n", title);
-    printSeparator();
-}
-
-// 打印床位类型的辅助函数
-void printBedType(enum BedType type) {
-    switch(type) {
-        case RegularBed: printf("普通床位"); break;
-        case ICUBed: printf("重症监护"); break;
-        case EmergencyBed: printf("急诊床位"); break;
-        default: printf("未知类型");
-    }
-}
-
-// 打印科室的辅助函数
-void printDepartment(int department) {
-    switch(department) {
-        case 1: printf("内科"); break;
-        case 2: printf("外科"); break;
-        case 3: printf("儿科"); break;
-        case 4: printf("妇科"); break;
-        case 5: printf("其他"); break;
-        default: printf("未知");
-    }
-}
-
-// 打印床位基本信息的辅助函数
-void printBedBasicInfo(struct Bed* bed) {
-    printf("床位ID: %d | ", bed->ID);
-    printf("状态: %s | ", bed->isOccupied ? "已占用" : "空闲");
-    printf("供氧设备: %s | ", bed->hasOxygen ? "有" : "无");
-    
-    printf("类型: ");
-    printBedType(bed->bedType);
-    printf(" | ");
-    
-    printf("病房号: %d | ", bed->ward);
-    printf("科室: ");
-    printDepartment(bed->department);
-}
-
-// 打印病人信息的辅助函数
-void printPatientInfo(struct Patient* patient) {
-    printf("\n  病人信息: ID-%d | 姓名-%s | ", 
-        patient->patientID, patient->name);
-    printf("性别-%s | ", patient->gender ? "男" : "女");
-    printf("电话-%s | ", patient->phone);
-    printf("诊断-%s | ", patient->diagnosis);
-    printf("年龄-%d", patient->age);
-}
-
-// 显示可用床位的函数，用于registerPatient内部调用
-void listAvailableBedsLocal() {
-    struct Bed* current = head;
-    int found = 0;
-    
-    printf("\n空闲床位列表：\n");
-    printf("----------------------------------------------------------------\n");
-    
-    while (current != NULL) {
-        if (!current->isOccupied) {
-            printBedBasicInfo(current);
-            printf("\n");
-            found = 1;
-        }
-        current = current->next;
-    }
-    
-    printf("----------------------------------------------------------------\n");
-    if (!found) {
-        printf("没有空闲床位\n");
-    }
-}
-
-// 清空输入缓冲区的简化版本
-void flushStdin() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
-}
-
-// 等待用户按回车的简化版本
-void pause() {
-    printf("\n按回车键继续...");
-    getchar();
-}
-
-void printMenu() {
-    printf("\n");
-    printf("╔═════════════════════════════════════════════════════════════════════════════════════════════════════╗\n");
-    printf("║                                  医院床位管理系统                                                    ║\n");
-    printf("╠═════════════════════════════════════════════════════════════════════════════════════════════════════╣\n");
-    printf("║                                    【系统功能导航】                                                  ║\n");
-    printf("║                                                                                                     ║\n");
-    printf("║  【病人与床位管理】                                                                                  ║\n");
-    printf("║  1--登记新病人        (录入病人信息)     ║ 2--分配床位         (为病人分配床位)                    ║\n");
-    printf("║  3--病人出院          (释放占用床位)     ║ 4--添加新床位       (新增床位基础信息)                  ║\n");
-    printf("║  5--修改床位信息      (修改床位属性)     ║ 6--删除床位信息     (移除指定床位)                      ║\n");
-    printf("║                                                                                                     ║\n");
-    printf("║  【查询与筛选功能】                                                                                  ║\n");
-    printf("║  7--根据床位号查询    (查询单个床位)     ║ 8--所有床位信息     (显示所有床位)                      ║\n");
-    printf("║  9--查询空闲床位      (显示可用床位)     ║ 10--按床位类型筛选  (普通/重症/急诊)                    ║\n");
-    printf("║  11--按病房号筛选     (查看指定病房)     ║ 12--按科室筛选      (内科/外科等筛选)                   ║\n");
-    printf("║  13--按床位ID排序     (ID升序排列)                                                                 ║\n");
-    printf("║                                                                                                     ║\n");
-    printf("║  【医生管理功能】                                                                                    ║\n");
-    printf("║  14--添加医生记录     (新增医生信息)     ║ 15--修改医生信息    (修改医生资料)                      ║\n");
-    printf("║  16--删除医生记录     (移除指定医生)     ║ 17--查询医生信息    (查询单个医生)                      ║\n");
-    printf("║  18--列出所有医生     (显示所有医生)     ║ 19--分配病人给医生  (建立医生病人关联)                  ║\n");
-    printf("║  20--分配病房给医生   (医生负责病房)     ║ 21--查询医生的病人  (显示医生负责病人)                  ║\n");
-    printf("║  22--查询医生的病房   (显示医生负责病房)                                                           ║\n");
-    printf("║                                                                                                     ║\n");
-    printf("║  24--保存并退出系统   (保存当前所有数据并退出程序)                                                   ║\n");
-    printf("╚═════════════════════════════════════════════════════════════════════════════════════════════════════╝\n");
-    printf("请输入对应数字选择功能(1-13, 14-22, 24): ");
-}
-
-void addBed() {
-    printOperationTitle("添加新床位");
-    
-    struct Bed* newBed = (struct Bed*)malloc(sizeof(struct Bed));
-    if (newBed == NULL) {
-        printf("内存分配失败\n");
-        pause();
-        return;
-    }
-
-    printf("输入床位ID: ");
-    scanf("%d", &newBed->ID);
-    flushStdin(); // 清空输入缓冲区
-    
-    // 检查ID是否已存在
-    struct Bed* current = head;
-    while (current != NULL) {
-        if (current->ID == newBed->ID) {
-            printf("错误: 床位ID %d 已存在，请使用其他ID\n", newBed->ID);
-            free(newBed);
-            pause();
-            return;
-        }
-        current = current->next;
-    }
-    
-    newBed->isOccupied = 0;
-    newBed->patient.patientID = -1; // 初始化为未分配
-    newBed->next = head;
-    head = newBed;
-
-    printf("输入是否有供氧设备 (1有, 0无): ");
-    scanf("%d", &newBed->hasOxygen);
-    flushStdin(); // 清空输入缓冲区
-    
-    printf("输入床位类型 (0普通床位, 1重症监护床位, 2急诊床位): ");
-    scanf("%d", (int*)&newBed->bedType);
-    flushStdin(); // 清空输入缓冲区
-    
-    printf("输入病房号: ");
-    scanf("%d", &newBed->ward);
-    flushStdin(); // 清空输入缓冲区
-    
-    printf("输入科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
-    scanf("%d", &newBed->department);
-    flushStdin(); // 清空输入缓冲区
-
-    printf("\n? 床位添加成功！新增床位信息如下：\n");
-    printSeparator();
-    printBedBasicInfo(newBed);
-    printf("\n");
-    printSeparator();
-    pause(); // 暂停等待用户按回车
-}
-
-void searchBedByID() {
-    printOperationTitle("床位信息查询");
-    
-    int id;
-    printf("输入要查找的床位ID: ");
-    scanf("%d", &id);
-    flushStdin(); // 清空输入缓冲区
-
-    struct Bed* current = head;
-    while (current != NULL) {
-        if (current->ID == id) {
-            printf("\n查询结果：\n");
-            printSeparator();
-            printBedBasicInfo(current);
-            if (current->isOccupied) {
-                printPatientInfo(&current->patient);
-            }
-            printf("\n");
-            printSeparator();
-            printf("\n按回车键返回主菜单..."); // 直接使用这种方式替代pause()
-            getchar();
-            return;
-        }
-        current = current->next;
-    }
-
-    printf("\n? 未找到床位ID为%d的床位\n", id);
-    printf("\n按回车键返回主菜单..."); // 直接使用这种方式替代pause()
-    getchar();
-}
-
-void modifyBed() {
-    printOperationTitle("修改床位信息");
-    
-    int id;
-    printf("输入要修改的床位ID: ");
-    scanf("%d", &id);
-    flushStdin(); // 清空输入缓冲区
-
-    struct Bed* current = head;
-    while (current != NULL) {
-        if (current->ID == id) {
-            printf("\n当前床位信息：\n");
-            printSeparator();
-            printBedBasicInfo(current);
-            printf("\n");
-            printSeparator();
-            
-            printf("\n请输入新的信息：\n");
-            printf("输入新的是否有供氧设备 (1有, 0无): ");
-            scanf("%d", &current->hasOxygen);
-            flushStdin();
-            
-            printf("输入新的床位类型 (0普通床位, 1重症监护床位, 2急诊床位): ");
-            scanf("%d", (int*)&current->bedType);
-            flushStdin();
-            
-            printf("输入新的病房号: ");
-            scanf("%d", &current->ward);
-            flushStdin();
-            
-            printf("输入新的科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
-            scanf("%d", &current->department);
-            flushStdin();
-            
-            printf("\n? 床位信息修改成功！更新后信息如下：\n");
-            printSeparator();
-            printBedBasicInfo(current);
-            printf("\n");
-            printSeparator();
-            pause();
-            return;
-        }
-        current = current->next;
-    }
-
-    printf("\n? 未找到床位ID为%d的床位\n", id);
-    pause();
-}
-
-void deleteBed() {
-    printOperationTitle("删除床位");
-    
-    int id;
-    printf("输入要删除的床位ID: ");
-    scanf("%d", &id);
-    flushStdin(); // 清空输入缓冲区
-
-    struct Bed* current = head;
-    struct Bed* prev = NULL;
-
-    while (current != NULL) {
-        if (current->ID == id) {
-            // 检查床位是否被占用
-            if (current->isOccupied) {
-                printf("\n? 错误：床位ID %d 当前有病人占用，无法删除。请先办理病人出院。\n", id);
-                pause();
-                return;
-            }
-            
-            if (prev == NULL) {
-                head = current->next;
-            }
-            else {
-                prev->next = current->next;
-            }
-            free(current);
-            printf("\n? 床位ID为%d的床位删除成功\n", id);
-            pause();
-            return;
-        }
-        prev = current;
-        current = current->next;
-    }
-
-    printf("\n? 未找到床位ID为%d的床位\n", id);
-    pause();
-}
-
-void listAllBeds() {
-    printOperationTitle("所有床位信息");
-    
-    struct Bed* current = head;
-    if (current == NULL) {
-        printf("当前没有床位信息\n");
-        printf("\n按回车键返回主菜单...");
-        getchar();
-        return;
-    }
-    
-    int count = 0;
-    int occupied = 0;
-    
-    printf("所有床位列表：\n");
-    printf("----------------------------------------------------------------\n");
-    
-    while (current != NULL) {
-        printBedBasicInfo(current);
-        
-        if (current->isOccupied) {
-            printPatientInfo(&current->patient);
-            occupied++;
-        }
-        printf("\n----------------------------------------------------------------\n");
-        current = current->next;
-        count++;
-    }
-    
-    printf("\n统计信息：总床位数: %d | 已占用: %d | 空闲: %d\n", count, occupied, count - occupied);
-    printf("\n按回车键返回主菜单...");
-    getchar();
-}
-
-// 获取用户输入的病人信息
-void getPatientInfo(struct Patient* patient) {
-    printf("输入病人ID: ");
-    scanf("%d", &patient->patientID);
-    flushStdin();
-    
-    printf("输入病人姓名: ");
-    scanf("%s", patient->name);
-    flushStdin();
-    
-    printf("输入病人性别 (1男, 0女): ");
-    scanf("%d", &patient->gender);
-    flushStdin();
-    
-    printf("输入病人电话: ");
-    scanf("%s", patient->phone);
-    flushStdin();
-    
-    printf("输入诊断结果: ");
-    scanf(" %[^\n]", patient->diagnosis);
-    flushStdin();
-    
-    printf("输入病人年龄: ");
-    scanf("%d", &patient->age);
-    flushStdin();
-}
-
-void registerPatient() {
-    printOperationTitle("病人登记");
-    
-    struct Patient newPatient;
-    printf("请输入病人基本信息:\n");
-    getPatientInfo(&newPatient);
-
-    // 这里可以将病人信息保存到文件或数据库中
-    printf("\n? 病人登记成功！\n");
-    
-    // 询问是否立即分配床位
-    int choice;
-    printf("\n是否现在为病人分配床位？(1是, 0否): ");
-    scanf("%d", &choice);
-    flushStdin();
-    
-    if (choice == 1) {
-        // 显示可用床位
-        listAvailableBedsLocal();
-        
-        // 检查是否有空闲床位
-        struct Bed* current = head;
-        int hasFreeBed = 0;
-        
-        while (current != NULL) {
-            if (!current->isOccupied) {
-                hasFreeBed = 1;
-                break;
-            }
-            current = current->next;
-        }
-        
-        if (!hasFreeBed) {
-            return; // listAvailableBedsLocal已经输出了没有空闲床位的消息
-        }
-        
-        // 选择床位
-        int bedID;
-        printf("\n输入要分配的床位ID: ");
-        scanf("%d", &bedID);
-        flushStdin();
-        
-        current = head;
-        while (current != NULL) {
-            if (current->ID == bedID && !current->isOccupied) {
-                current->patient = newPatient;
-                current->isOccupied = 1;
-                printf("\n? 床位分配成功！病人 %s 已分配到床位 %d\n", newPatient.name, bedID);
-                pause();
-                return;
-            } else if (current->ID == bedID && current->isOccupied) {
-                printf("\n? 该床位已被占用，无法分配\n");
-                pause();
-                return;
-            }
-            current = current->next;
-        }
-        
-        printf("\n? 未找到床位ID为%d的空闲床位\n", bedID);
-        pause();
-    } else {
-        pause();
-    }
-}
-
-void assignBed() {
-    printOperationTitle("床位分配");
-    
-    int bedID;
-    
-    printf("输入要分配的床位ID: ");
-    scanf("%d", &bedID);
-    flushStdin();
-
-    struct Bed* current = head;
-    while (current != NULL) {
-        if (current->ID == bedID && !current->isOccupied) {
-            printf("\n请输入病人信息:\n");
-            getPatientInfo(&current->patient);
-            current->isOccupied = 1;
-            printf("\n? 床位分配成功！病人 %s 已分配到床位 %d\n", current->patient.name, bedID);
-            pause();
-            return;
-        } else if (current->ID == bedID && current->isOccupied) {
-            printf("\n? 该床位已被占用，无法分配。当前占用病人: %s\n", current->patient.name);
-            pause();
-            return;
-        }
-        current = current->next;
-    }
-
-    printf("\n? 未找到床位ID为%d的空闲床位\n", bedID);
-    pause();
-}
-
-void dischargePatient() {
-    printOperationTitle("病人出院");
-    
-    int id;
-    printf("输入要办理出院的床位ID: ");
-    scanf("%d", &id);
-    flushStdin();
-
-    struct Bed* current = head;
-    while (current != NULL) {
-        if (current->ID == id && current->isOccupied) {
-            printf("\n当前占用信息:\n");
-            printSeparator();
-            printf("床位ID: %d | 病人姓名: %s | 诊断: %s\n", 
-                   current->ID, current->patient.name, current->patient.diagnosis);
-            printSeparator();
-                   
-            printf("\n确认办理出院? (1确认, 0取消): ");
-            int confirm;
-            scanf("%d", &confirm);
-            flushStdin();
-            
-            if (confirm) {
-                printf("\n? 病人 %s (ID: %d) 已办理出院，床位已释放\n", 
-                       current->patient.name, current->patient.patientID);
-                current->isOccupied = 0;
-                current->patient.patientID = -1;
-            } else {
-                printf("\n出院操作已取消\n");
-            }
-            pause();
-            return;
-        } else if (current->ID == id && !current->isOccupied) {
-            printf("\n? 该床位本就空闲，无需办理出院\n");
-            pause();
-            return;
-        }
-        current = current->next;
-    }
-
-    printf("\n? 未找到床位ID为%d的已占用床位\n", id);
-    pause();
-}
-
-// 修改加载函数，使用CSV格式
-void loadBedsFromFile(const char* filename) {
-    printf("正在加载床位数据...\n");
-    
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        printf("无法打开文件 %s，将创建新文件\n", filename);
-        return;
-    }
-
-    int recordCount = 0;
-    char line[1024]; // 足够大的缓冲区来存储一行CSV数据
-    
-    // 读取并跳过CSV文件头
-    if (fgets(line, sizeof(line), file) == NULL) {
-        printf("文件为空或格式不正确\n");
-        fclose(file);
-        return;
-    }
-    
-    // 读取数据记录
-    while (fgets(line, sizeof(line), file) != NULL) {
-        struct Bed* newBed = (struct Bed*)malloc(sizeof(struct Bed));
-        if (newBed == NULL) {
-            printf("内存分配失败\n");
-            fclose(file);
-            return;
-        }
-        
-        // 初始化字符串字段
-        newBed->patient.name[0] = '\0';
-        newBed->patient.phone[0] = '\0';
-        newBed->patient.diagnosis[0] = '\0';
-        
-        // 使用sscanf解析CSV行
-        char nameBuf[50], phoneBuf[20], diagnosisBuf[100];
-        int itemsRead = sscanf(line, "%d,%d,%d,%d,%d,%d,%d,%[^,],%d,%[^,],%[^,],%d",
-            &newBed->ID,
-            &newBed->isOccupied,
-            &newBed->hasOxygen,
-            (int*)&newBed->bedType,
-            &newBed->ward,
-            &newBed->department,
-            &newBed->patient.patientID,
-            nameBuf,
-            &newBed->patient.gender,
-            phoneBuf, 
-            diagnosisBuf,
-            &newBed->patient.age);
-        
-        // 检查是否成功读取所有字段
-        if (itemsRead < 12) {
-            printf("警告: 行格式不正确, 只读取到%d个字段，跳过此行\n", itemsRead);
-            free(newBed);
-            continue;
-        }
-        
-        // 复制字符串字段
-        strncpy(newBed->patient.name, nameBuf, sizeof(newBed->patient.name) - 1);
-        newBed->patient.name[sizeof(newBed->patient.name) - 1] = '\0'; // 确保以null结尾
-        
-        strncpy(newBed->patient.phone, phoneBuf, sizeof(newBed->patient.phone) - 1);
-        newBed->patient.phone[sizeof(newBed->patient.phone) - 1] = '\0';
-        
-        strncpy(newBed->patient.diagnosis, diagnosisBuf, sizeof(newBed->patient.diagnosis) - 1);
-        newBed->patient.diagnosis[sizeof(newBed->patient.diagnosis) - 1] = '\0';
-        
-        // 添加到链表
-        newBed->next = head;
-        head = newBed;
-        recordCount++;
-        
-        // 安全检查
-        if (recordCount > 1000) {
-            printf("加载记录数过多，可能存在文件格式问题，已停止加载\n");
-            break;
-        }
-    }
-
-    fclose(file);
-    printf("床位信息加载成功！共加载 %d 条记录\n", recordCount);
-}
-
-// 菜单选项6使用的函数，显示所有空闲床位
-void listAvailableBeds() {
-    printOperationTitle("查询空闲床位");
-    listAvailableBedsLocal(); // 复用已经写好的函数
-    printf("\n按回车键返回主菜单...");
-    getchar();
-}
-
-// 使用更高效的快速排序替代冒泡排序
-void sortBedsByID() {
-    printOperationTitle("床位排序");
-    
-    if (head == NULL || head->next == NULL) {
-        printf("当前床位数量不足，无需排序\n");
-        pause();
-        return; // 0或1个节点不需要排序
-    }
-
-    // 将链表转换为数组以便使用快速排序
-    int count = 0;
-    struct Bed* current = head;
-    while (current != NULL) {
-        count++;
-        current = current->next;
-    }
-
-    struct Bed** bedArray = (struct Bed**)malloc(count * sizeof(struct Bed*));
-    if (bedArray == NULL) {
-        printf("内存分配失败\n");
-        return;
-    }
-
-    current = head;
-    for (int i = 0; i < count; i++) {
-        bedArray[i] = current;
-        current = current->next;
-    }
-
-    // 使用简单插入排序 - 对于小数据集比较高效
-    for (int i = 1; i < count; i++) {
-        struct Bed* key = bedArray[i];
-        int j = i - 1;
-
-        while (j >= 0 && bedArray[j]->ID > key->ID) {
-            bedArray[j + 1] = bedArray[j];
-            j--;
-        }
-        bedArray[j + 1] = key;
-    }
-
-    // 重建排序后的链表
-    head = bedArray[0];
-    for (int i = 0; i < count - 1; i++) {
-        bedArray[i]->next = bedArray[i + 1];
-    }
-    bedArray[count - 1]->next = NULL;
-
-    free(bedArray);
-    printf("\n? 已按床位ID排序完成！排序结果如下：\n");
-    listAllBeds();
-}
-
-void filterBedsByType() {
-    printOperationTitle("按床位类型筛选");
-    
-    int bedType;
-    printf("输入要筛选的床位类型 (0普通床位, 1重症监护床位, 2急诊床位): ");
-    scanf("%d", &bedType);
-    flushStdin();
-
-    struct Bed* current = head;
-    int found = 0;
-    int total = 0;
-    int occupied = 0;
-    
-    printf("\n床位类型为 ");
-    printBedType(bedType);
-    printf(" 的床位列表：\n");
-    printf("----------------------------------------------------------------\n");
-    
-    while (current != NULL) {
-        if (current->bedType == bedType) {
-            printBedBasicInfo(current);
-            
-            if (current->isOccupied) {
-                printPatientInfo(&current->patient);
-                occupied++;
-            }
-            printf("\n----------------------------------------------------------------\n");
-            found = 1;
-            total++;
-        }
-        current = current->next;
-    }
-    
-    if (!found) {
-        printf("未找到床位类型为%d的床位\n", bedType);
-    } else {
-        printf("\n统计信息：该类型总床位数: %d | 已占用: %d | 空闲: %d\n", total, occupied, total - occupied);
-    }
-    pause();
-}
-
-// 修改保存函数，使用CSV格式
-void saveBedsToFile(const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (file == NULL) {
-        printf("无法打开文件 %s\n", filename);
-        pause();
-        return;
-    }
-
-    // 写入CSV文件头
-    fprintf(file, "ID,isOccupied,hasOxygen,bedType,ward,department,patientID,name,gender,phone,diagnosis,age\n");
-    
-    struct Bed* current = head;
-    int count = 0;
-    while (current != NULL) {
-        // 写入CSV格式的数据行
-        // 注意: 字符串字段使用双引号包围，避免逗号分隔符问题
-        fprintf(file, "%d,%d,%d,%d,%d,%d,%d,\"%s\",%d,\"%s\",\"%s\",%d\n",
-            current->ID,
-            current->isOccupied,
-            current->hasOxygen,
-            current->bedType,
-            current->ward,
-            current->department,
-            current->patient.patientID,
-            current->patient.name,
-            current->patient.gender,
-            current->patient.phone,
-            current->patient.diagnosis,
-            current->patient.age);
-
-        current = current->next;
-        count++;
-    }
-
-    fclose(file);
-    printf("\n? 床位信息保存成功！共保存 %d 条记录到CSV文件\n", count);
-}
-
-void filterBedsByWard() {
-    printOperationTitle("按病房号筛选");
-    
-    int ward;
-    printf("输入要筛选的病房号: ");
-    scanf("%d", &ward);
-    flushStdin();
-
-    struct Bed* current = head;
-    int found = 0;
-    int total = 0;
-    int occupied = 0;
-    
-    printf("\n病房号为 %d 的床位列表：\n", ward);
-    printf("----------------------------------------------------------------\n");
-    
-    while (current != NULL) {
-        if (current->ward == ward) {
-            printBedBasicInfo(current);
-            
-            if (current->isOccupied) {
-                printPatientInfo(&current->patient);
-                occupied++;
-            }
-            printf("\n----------------------------------------------------------------\n");
-            found = 1;
-            total++;
-        }
-        current = current->next;
-    }
-    
-    if (!found) {
-        printf("未找到病房号为%d的床位\n", ward);
-    } else {
-        printf("\n统计信息：该病房总床位数: %d | 已占用: %d | 空闲: %d\n", total, occupied, total - occupied);
-    }
-    pause();
-}
-
-void filterBedsByDepartment() {
-    printOperationTitle("按科室筛选");
-    
-    int department;
-    printf("输入要筛选的科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
-    scanf("%d", &department);
-    flushStdin();
-
-    struct Bed* current = head;
-    int found = 0;
-    int total = 0;
-    int occupied = 0;
-    
-    printf("\n科室 ");
-    printDepartment(department);
-    printf(" 的床位列表：\n");
-    printf("----------------------------------------------------------------\n");
-    
-    while (current != NULL) {
-        if (current->department == department) {
-            printBedBasicInfo(current);
-            
-            if (current->isOccupied) {
-                printPatientInfo(&current->patient);
-                occupied++;
-            }
-            printf("\n----------------------------------------------------------------\n");
-            found = 1;
-            total++;
-        }
-        current = current->next;
-    }
-    
-    if (!found) {
-        printf("未找到科室编号为%d的床位\n", department);
-    } else {
-        printf("\n统计信息：该科室总床位数: %d | 已占用: %d | 空闲: %d\n", total, occupied, total - occupied);
-    }
-    pause();
-}
-
-// 释放内存
-void cleanupMemory() {
-    // 床位链表内存清理
-    struct Bed* current = head;
-    while (current != NULL) {
-        struct Bed* temp = current;
-        current = current->next;
-        free(temp);
-    }
-    
-    // 医生链表内存清理
-    struct Doctor* currentDoctor = doctorHead;
-    while (currentDoctor != NULL) {
-        struct Doctor* tempDoctor = currentDoctor;
-        currentDoctor = currentDoctor->next;
-        free(tempDoctor);
-    }
-    
-    // 医生-病人关联链表内存清理
-    struct DoctorPatientRelation* currentDP = doctorPatientHead;
-    while (currentDP != NULL) {
-        struct DoctorPatientRelation* tempDP = currentDP;
-        currentDP = currentDP->next;
-        free(tempDP);
-    }
-    
-    // 医生-病房关联链表内存清理
-    struct DoctorWardRelation* currentDW = doctorWardHead;
-    while (currentDW != NULL) {
-        struct DoctorWardRelation* tempDW = currentDW;
-        currentDW = currentDW->next;
-        free(tempDW);
-    }
-}
-
-// 打印医生职称的辅助函数
-void printQualification(int qualification) {
-    switch(qualification) {
-        case 1: printf("住院医师"); break;
-        case 2: printf("主治医师"); break;
-        case 3: printf("副主任医师"); break;
-        case 4: printf("主任医师"); break;
-        default: printf("未知职称");
-    }
-}
-
-// 打印医生信息的辅助函数
-void printDoctorBasicInfo(struct Doctor* doctor) {
-    printf("医生ID: %d | ", doctor->doctorID);
-    printf("姓名: %s | ", doctor->name);
-    printf("性别: %s | ", doctor->gender ? "男" : "女");
-    printf("电话: %s | ", doctor->phone);
-    
-    printf("科室: ");
-    printDepartment(doctor->department);
-    printf(" | ");
-    
-    printf("专业: %s | ", doctor->specialization);
-    
-    printf("职称: ");
-    printQualification(doctor->qualification);
-    printf(" | ");
-    
-    printf("办公室: %s", doctor->officeLocation);
-}
-
-// 获取用户输入的医生信息
-void getDoctorInfo(struct Doctor* doctor) {
-    printf("输入医生ID: ");
-    scanf("%d", &doctor->doctorID);
-    flushStdin();
-    
-    printf("输入医生姓名: ");
-    scanf("%s", doctor->name);
-    flushStdin();
-    
-    printf("输入医生性别 (1男, 0女): ");
-    scanf("%d", &doctor->gender);
-    flushStdin();
-    
-    printf("输入医生电话: ");
-    scanf("%s", doctor->phone);
-    flushStdin();
-    
-    printf("输入所属科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
-    scanf("%d", &doctor->department);
-    flushStdin();
-    
-    printf("输入专业/专长: ");
-    scanf(" %[^\n]", doctor->specialization);
-    flushStdin();
-    
-    printf("输入职称 (1-住院医师, 2-主治医师, 3-副主任医师, 4-主任医师): ");
-    scanf("%d", &doctor->qualification);
-    flushStdin();
-    
-    printf("输入办公室位置: ");
-    scanf(" %[^\n]", doctor->officeLocation);
-    flushStdin();
-}
-
-// 从CSV文件加载医生数据
-void loadDoctorsFromFile(const char* filename) {
-    printf("正在加载医生数据...\n");
-    
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        printf("无法打开文件 %s，将创建新文件\n", filename);
-        return;
-    }
-
-    int recordCount = 0;
-    char line[1024]; // 足够大的缓冲区来存储一行CSV数据
-    
-    // 读取并跳过CSV文件头
-    if (fgets(line, sizeof(line), file) == NULL) {
-        printf("文件为空或格式不正确\n");
-        fclose(file);
-        return;
-    }
-    
-    // 读取数据记录
-    while (fgets(line, sizeof(line), file) != NULL) {
-        struct Doctor* newDoctor = (struct Doctor*)malloc(sizeof(struct Doctor));
-        if (newDoctor == NULL) {
-            printf("内存分配失败\n");
-            fclose(file);
-            return;
-        }
-        
-        // 初始化字符串字段
-        newDoctor->name[0] = '\0';
-        newDoctor->phone[0] = '\0';
-        newDoctor->specialization[0] = '\0';
-        newDoctor->officeLocation[0] = '\0';
-        
-        // 使用sscanf解析CSV行
-        char nameBuf[50], phoneBuf[20], specializationBuf[50], officeLocationBuf[30];
-        int itemsRead = sscanf(line, "%d,%[^,],%d,%[^,],%d,%[^,],%d,%[^,]",
-            &newDoctor->doctorID,
-            nameBuf,
-            &newDoctor->gender,
-            phoneBuf,
-            &newDoctor->department,
-            specializationBuf,
-            &newDoctor->qualification,
-            officeLocationBuf);
-        
-        // 检查是否成功读取所有字段
-        if (itemsRead < 8) {
-            printf("警告: 行格式不正确, 只读取到%d个字段，跳过此行\n", itemsRead);
-            free(newDoctor);
-            continue;
-        }
-        
-        // 复制字符串字段
-        strncpy(newDoctor->name, nameBuf, sizeof(newDoctor->name) - 1);
-        newDoctor->name[sizeof(newDoctor->name) - 1] = '\0'; // 确保以null结尾
-        
-        strncpy(newDoctor->phone, phoneBuf, sizeof(newDoctor->phone) - 1);
-        newDoctor->phone[sizeof(newDoctor->phone) - 1] = '\0';
-        
-        strncpy(newDoctor->specialization, specializationBuf, sizeof(newDoctor->specialization) - 1);
-        newDoctor->specialization[sizeof(newDoctor->specialization) - 1] = '\0';
-        
-        strncpy(newDoctor->officeLocation, officeLocationBuf, sizeof(newDoctor->officeLocation) - 1);
-        newDoctor->officeLocation[sizeof(newDoctor->officeLocation) - 1] = '\0';
-        
-        // 添加到链表
-        newDoctor->next = doctorHead;
-        doctorHead = newDoctor;
-        recordCount++;
-    }
-
-    fclose(file);
-    printf("医生信息加载成功！共加载 %d 条记录\n", recordCount);
-}
-
-// 保存医生数据到CSV文件
-void saveDoctorsToFile(const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (file == NULL) {
-        printf("无法打开文件 %s\n", filename);
-        pause();
-        return;
-    }
-
-    // 写入CSV文件头
-    fprintf(file, "doctorID,name,gender,phone,department,specialization,qualification,officeLocation\n");
-    
-    struct Doctor* current = doctorHead;
-    int count = 0;
-    while (current != NULL) {
-        // 写入CSV格式的数据行
-        fprintf(file, "%d,\"%s\",%d,\"%s\",%d,\"%s\",%d,\"%s\"\n",
-            current->doctorID,
-            current->name,
-            current->gender,
-            current->phone,
-            current->department,
-            current->specialization,
-            current->qualification,
-            current->officeLocation);
-
-        current = current->next;
-        count++;
-    }
-
-    fclose(file);
-    printf("\n? 医生信息保存成功！共保存 %d 条记录到CSV文件\n", count);
-}
-
-// 从CSV文件加载医生-病人关联数据
-void loadDoctorPatientFromFile(const char* filename) {
-    printf("正在加载医生-病人关联数据...\n");
-    
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        printf("无法打开文件 %s，将创建新文件\n", filename);
-        return;
-    }
-
-    int recordCount = 0;
-    char line[1024]; // 足够大的缓冲区来存储一行CSV数据
-    
-    // 读取并跳过CSV文件头
-    if (fgets(line, sizeof(line), file) == NULL) {
-        printf("文件为空或格式不正确\n");
-        fclose(file);
-        return;
-    }
-    
-    // 读取数据记录
-    while (fgets(line, sizeof(line), file) != NULL) {
-        struct DoctorPatientRelation* newRelation = (struct DoctorPatientRelation*)malloc(sizeof(struct DoctorPatientRelation));
-        if (newRelation == NULL) {
-            printf("内存分配失败\n");
-            fclose(file);
-            return;
-        }
-        
-        // 初始化字符串字段
-        newRelation->notes[0] = '\0';
-        newRelation->startDate[0] = '\0';
-        
-        // 使用sscanf解析CSV行
-        char notesBuf[100], startDateBuf[20];
-        int itemsRead = sscanf(line, "%d,%d,%[^,],%[^,]",
-            &newRelation->doctorID,
-            &newRelation->patientID,
-            notesBuf,
-            startDateBuf);
-        
-        // 检查是否成功读取所有字段
-        if (itemsRead < 4) {
-            printf("警告: 行格式不正确, 只读取到%d个字段，跳过此行\n", itemsRead);
-            free(newRelation);
-            continue;
-        }
-        
-        // 复制字符串字段
-        strncpy(newRelation->notes, notesBuf, sizeof(newRelation->notes) - 1);
-        newRelation->notes[sizeof(newRelation->notes) - 1] = '\0'; // 确保以null结尾
-        
-        strncpy(newRelation->startDate, startDateBuf, sizeof(newRelation->startDate) - 1);
-        newRelation->startDate[sizeof(newRelation->startDate) - 1] = '\0';
-        
-        // 添加到链表
-        newRelation->next = doctorPatientHead;
-        doctorPatientHead = newRelation;
-        recordCount++;
-    }
-
-    fclose(file);
-    printf("医生-病人关联数据加载成功！共加载 %d 条记录\n", recordCount);
-}
-
-// 保存医生-病人关联数据到CSV文件
-void saveDoctorPatientToFile(const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (file == NULL) {
-        printf("无法打开文件 %s\n", filename);
-        pause();
-        return;
-    }
-
-    // 写入CSV文件头
-    fprintf(file, "doctorID,patientID,notes,startDate\n");
-    
-    struct DoctorPatientRelation* current = doctorPatientHead;
-    int count = 0;
-    while (current != NULL) {
-        // 写入CSV格式的数据行
-        fprintf(file, "%d,%d,\"%s\",\"%s\"\n",
-            current->doctorID,
-            current->patientID,
-            current->notes,
-            current->startDate);
-
-        current = current->next;
-        count++;
-    }
-
-    fclose(file);
-    printf("\n? 医生-病人关联数据保存成功！共保存 %d 条记录到CSV文件\n", count);
-}
-
-// 从CSV文件加载医生-病房关联数据
-void loadDoctorWardFromFile(const char* filename) {
-    printf("正在加载医生-病房关联数据...\n");
-    
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        printf("无法打开文件 %s，将创建新文件\n", filename);
-        return;
-    }
-
-    int recordCount = 0;
-    char line[1024]; // 足够大的缓冲区来存储一行CSV数据
-    
-    // 读取并跳过CSV文件头
-    if (fgets(line, sizeof(line), file) == NULL) {
-        printf("文件为空或格式不正确\n");
-        fclose(file);
-        return;
-    }
-    
-    // 读取数据记录
-    while (fgets(line, sizeof(line), file) != NULL) {
-        struct DoctorWardRelation* newRelation = (struct DoctorWardRelation*)malloc(sizeof(struct DoctorWardRelation));
-        if (newRelation == NULL) {
-            printf("内存分配失败\n");
-            fclose(file);
-            return;
-        }
-        
-        // 初始化字符串字段
-        newRelation->scheduleInfo[0] = '\0';
-        
-        // 使用sscanf解析CSV行
-        char scheduleInfoBuf[100];
-        int itemsRead = sscanf(line, "%d,%d,%d,%[^,]",
-            &newRelation->doctorID,
-            &newRelation->wardNumber,
-            &newRelation->isHeadDoctor,
-            scheduleInfoBuf);
-        
-        // 检查是否成功读取所有字段
-        if (itemsRead < 4) {
-            printf("警告: 行格式不正确, 只读取到%d个字段，跳过此行\n", itemsRead);
-            free(newRelation);
-            continue;
-        }
-        
-        // 复制字符串字段
-        strncpy(newRelation->scheduleInfo, scheduleInfoBuf, sizeof(newRelation->scheduleInfo) - 1);
-        newRelation->scheduleInfo[sizeof(newRelation->scheduleInfo) - 1] = '\0'; // 确保以null结尾
-        
-        // 添加到链表
-        newRelation->next = doctorWardHead;
-        doctorWardHead = newRelation;
-        recordCount++;
-    }
-
-    fclose(file);
-    printf("医生-病房关联数据加载成功！共加载 %d 条记录\n", recordCount);
-}
-
-// 保存医生-病房关联数据到CSV文件
-void saveDoctorWardToFile(const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (file == NULL) {
-        printf("无法打开文件 %s\n", filename);
-        pause();
-        return;
-    }
-
-    // 写入CSV文件头
-    fprintf(file, "doctorID,wardNumber,isHeadDoctor,scheduleInfo\n");
-    
-    struct DoctorWardRelation* current = doctorWardHead;
-    int count = 0;
-    while (current != NULL) {
-        // 写入CSV格式的数据行
-        fprintf(file, "%d,%d,%d,\"%s\"\n",
-            current->doctorID,
-            current->wardNumber,
-            current->isHeadDoctor,
-            current->scheduleInfo);
-
-        current = current->next;
-        count++;
-    }
-
-    fclose(file);
-    printf("\n? 医生-病房关联数据保存成功！共保存 %d 条记录到CSV文件\n", count);
-}
-
-// 添加医生记录
-void addDoctor() {
-    printOperationTitle("添加医生记录");
-    
-    struct Doctor* newDoctor = (struct Doctor*)malloc(sizeof(struct Doctor));
-    if (newDoctor == NULL) {
-        printf("内存分配失败\n");
-        pause();
-        return;
-    }
-
-    printf("输入医生ID: ");
-    scanf("%d", &newDoctor->doctorID);
-    flushStdin(); // 清空输入缓冲区
-    
-    // 检查ID是否已存在
-    struct Doctor* current = doctorHead;
-    while (current != NULL) {
-        if (current->doctorID == newDoctor->doctorID) {
-            printf("错误: 医生ID %d 已存在，请使用其他ID\n", newDoctor->doctorID);
-            free(newDoctor);
-            pause();
-            return;
-        }
-        current = current->next;
-    }
-    
-    // 获取医生其他信息
-    printf("输入医生姓名: ");
-    scanf("%s", newDoctor->name);
-    flushStdin();
-    
-    printf("输入医生性别 (1男, 0女): ");
-    scanf("%d", &newDoctor->gender);
-    flushStdin();
-    
-    printf("输入医生电话: ");
-    scanf("%s", newDoctor->phone);
-    flushStdin();
-    
-    printf("输入所属科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
-    scanf("%d", &newDoctor->department);
-    flushStdin();
-    
-    printf("输入专业/专长: ");
-    scanf(" %[^\n]", newDoctor->specialization);
-    flushStdin();
-    
-    printf("输入职称 (1-住院医师, 2-主治医师, 3-副主任医师, 4-主任医师): ");
-    scanf("%d", &newDoctor->qualification);
-    flushStdin();
-    
-    printf("输入办公室位置: ");
-    scanf(" %[^\n]", newDoctor->officeLocation);
-    flushStdin();
-    
-    // 添加到链表
-    newDoctor->next = doctorHead;
-    doctorHead = newDoctor;
-
-    printf("\n? 医生添加成功！新增医生信息如下：\n");
-    printSeparator();
-    printDoctorBasicInfo(newDoctor);
-    printf("\n");
-    printSeparator();
-    pause();
-}
-
-// 修改医生信息
-void modifyDoctor() {
-    printOperationTitle("修改医生信息");
-    
-    int id;
-    printf("输入要修改的医生ID: ");
-    scanf("%d", &id);
-    flushStdin();
-
-    struct Doctor* current = doctorHead;
-    while (current != NULL) {
-        if (current->doctorID == id) {
-            printf("\n当前医生信息：\n");
-            printSeparator();
-            printDoctorBasicInfo(current);
-            printf("\n");
-            printSeparator();
-            
-            printf("\n请输入新的信息：\n");
-            printf("输入新的姓名: ");
-            scanf("%s", current->name);
-            flushStdin();
-            
-            printf("输入新的性别 (1男, 0女): ");
-            scanf("%d", &current->gender);
-            flushStdin();
-            
-            printf("输入新的电话: ");
-            scanf("%s", current->phone);
-            flushStdin();
-            
-            printf("输入新的科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
-            scanf("%d", &current->department);
-            flushStdin();
-            
-            printf("输入新的专业/专长: ");
-            scanf(" %[^\n]", current->specialization);
-            flushStdin();
-            
-            printf("输入新的职称 (1-住院医师, 2-主治医师, 3-副主任医师, 4-主任医师): ");
-            scanf("%d", &current->qualification);
-            flushStdin();
-            
-            printf("输入新的办公室位置: ");
-            scanf(" %[^\n]", current->officeLocation);
-            flushStdin();
-            
-            printf("\n? 医生信息修改成功！更新后信息如下：\n");
-            printSeparator();
-            printDoctorBasicInfo(current);
-            printf("\n");
-            printSeparator();
-            pause();
-            return;
-        }
-        current = current->next;
-    }
-
-    printf("\n? 未找到医生ID为%d的医生\n", id);
-    pause();
-}
-
-// 检查医生是否有关联的病人
-int doctorHasPatients(int doctorID) {
-    struct DoctorPatientRelation* current = doctorPatientHead;
-    while (current != NULL) {
-        if (current->doctorID == doctorID) {
-            return 1; // 有关联的病人
-        }
-        current = current->next;
-    }
-    return 0; // 没有关联的病人
-}
-
-// 检查医生是否有关联的病房
-int doctorHasWards(int doctorID) {
-    struct DoctorWardRelation* current = doctorWardHead;
-    while (current != NULL) {
-        if (current->doctorID == doctorID) {
-            return 1; // 有关联的病房
-        }
-        current = current->next;
-    }
-    return 0; // 没有关联的病房
-}
-
-// 删除医生记录
-void deleteDoctor() {
-    printOperationTitle("删除医生记录");
-    
-    int id;
-    printf("输入要删除的医生ID: ");
-    scanf("%d", &id);
-    flushStdin();
-
-    // 检查医生是否有关联的病人或病房
-    if (doctorHasPatients(id)) {
-        printf("\n? 错误：医生ID %d 当前有关联的病人，无法删除。请先解除病人关联。\n", id);
-        pause();
-        return;
-    }
-    
-    if (doctorHasWards(id)) {
-        printf("\n? 错误：医生ID %d 当前有关联的病房，无法删除。请先解除病房关联。\n", id);
-        pause();
-        return;
-    }
-
-    struct Doctor* current = doctorHead;
-    struct Doctor* prev = NULL;
-
-    while (current != NULL) {
-        if (current->doctorID == id) {
-            if (prev == NULL) {
-                doctorHead = current->next;
-            }
-            else {
-                prev->next = current->next;
-            }
-            free(current);
-            printf("\n? 医生ID为%d的记录删除成功\n", id);
-            pause();
-            return;
-        }
-        prev = current;
-        current = current->next;
-    }
-
-    printf("\n? 未找到医生ID为%d的医生\n", id);
-    pause();
-}
-
-// 根据ID查询医生信息
-void searchDoctorByID() {
-    printOperationTitle("医生信息查询");
-    
-    int id;
-    printf("输入要查找的医生ID: ");
-    scanf("%d", &id);
-    flushStdin();
-
-    struct Doctor* current = doctorHead;
-    while (current != NULL) {
-        if (current->doctorID == id) {
-            printf("\n查询结果：\n");
-            printSeparator();
-            printDoctorBasicInfo(current);
-            printf("\n");
-            printSeparator();
-            
-            // 查询该医生负责的病人
-            printf("\n该医生负责的病人列表：\n");
-            printSeparator();
-            int patientCount = 0;
-            struct DoctorPatientRelation* dpRelation = doctorPatientHead;
-            while (dpRelation != NULL) {
-                if (dpRelation->doctorID == id) {
-                    printf("病人ID: %d | 医疗备注: %s | 开始日期: %s\n", 
-                           dpRelation->patientID, dpRelation->notes, dpRelation->startDate);
-                    patientCount++;
-                }
-                dpRelation = dpRelation->next;
-            }
-            
-            if (patientCount == 0) {
-                printf("该医生暂无负责的病人\n");
-            }
-            printSeparator();
-            
-            // 查询该医生负责的病房
-            printf("\n该医生负责的病房列表：\n");
-            printSeparator();
-            int wardCount = 0;
-            struct DoctorWardRelation* dwRelation = doctorWardHead;
-            while (dwRelation != NULL) {
-                if (dwRelation->doctorID == id) {
-                    printf("病房号: %d | 主治医生: %s | 查房安排: %s\n", 
-                           dwRelation->wardNumber, 
-                           dwRelation->isHeadDoctor ? "是" : "否", 
-                           dwRelation->scheduleInfo);
-                    wardCount++;
-                }
-                dwRelation = dwRelation->next;
-            }
-            
-            if (wardCount == 0) {
-                printf("该医生暂无负责的病房\n");
-            }
-            printSeparator();
-            
-            pause();
-            return;
-        }
-        current = current->next;
-    }
-
-    printf("\n? 未找到医生ID为%d的医生\n", id);
-    pause();
-}
-
-// 列出所有医生信息
-void listAllDoctors() {
-    printOperationTitle("所有医生信息");
-    
-    struct Doctor* current = doctorHead;
-    if (current == NULL) {
-        printf("当前没有医生信息\n");
-        pause();
-        return;
-    }
-    
-    int count = 0;
-    int deptCount[6] = {0}; // 用于统计各科室医生数量，索引0未使用
-    
-    printf("所有医生列表：\n");
-    printf("----------------------------------------------------------------\n");
-    
-    while (current != NULL) {
-        printDoctorBasicInfo(current);
-        printf("\n----------------------------------------------------------------\n");
-        
-        // 统计各科室医生数量
-        if (current->department >= 1 && current->department <= 5) {
-            deptCount[current->department]++;
-        }
-        
-        current = current->next;
-        count++;
-    }
-    
-    printf("\n统计信息：总医生数: %d | ", count);
-    printf("内科: %d | 外科: %d | 儿科: %d | 妇科: %d | 其他: %d\n", 
-           deptCount[1], deptCount[2], deptCount[3], deptCount[4], deptCount[5]);
-    
-    pause();
-}
-
-// 检查病人是否存在
-int patientExists(int patientID) {
-    struct Bed* current = head;
-    while (current != NULL) {
-        if (current->isOccupied && current->patient.patientID == patientID) {
-            return 1;
-        }
-        current = current->next;
-    }
-    return 0;
-}
-
-// 检查病房是否存在
-int wardExists(int wardNumber) {
-    struct Bed* current = head;
-    while (current != NULL) {
-        if (current->ward == wardNumber) {
-            return 1;
-        }
-        current = current->next;
-    }
-    return 0;
-}
-
-// 检查医生是否存在
-int doctorExists(int doctorID) {
-    struct Doctor* current = doctorHead;
-    while (current != NULL) {
-        if (current->doctorID == doctorID) {
-            return 1;
-        }
-        current = current->next;
-    }
-    return 0;
-}
-
-// 检查医生-病人关联是否已存在
-int doctorPatientRelationExists(int doctorID, int patientID) {
-    struct DoctorPatientRelation* current = doctorPatientHead;
-    while (current != NULL) {
-        if (current->doctorID == doctorID && current->patientID == patientID) {
-            return 1;
-        }
-        current = current->next;
-    }
-    return 0;
-}
-
-// 检查医生-病房关联是否已存在
-int doctorWardRelationExists(int doctorID, int wardNumber) {
-    struct DoctorWardRelation* current = doctorWardHead;
-    while (current != NULL) {
-        if (current->doctorID == doctorID && current->wardNumber == wardNumber) {
-            return 1;
-        }
-        current = current->next;
-    }
-    return 0;
-}
-
-// 分配病人给医生
-void assignPatientToDoctor() {
-    printOperationTitle("分配病人给医生");
-    
-    int doctorID, patientID;
-    
-    printf("输入医生ID: ");
-    scanf("%d", &doctorID);
-    flushStdin();
-    
-    // 检查医生是否存在
-    if (!doctorExists(doctorID)) {
-        printf("\n? 错误：医生ID %d 不存在\n", doctorID);
-        pause();
-        return;
-    }
-    
-    printf("输入病人ID: ");
-    scanf("%d", &patientID);
-    flushStdin();
-    
-    // 检查病人是否存在
-    if (!patientExists(patientID)) {
-        printf("\n? 错误：病人ID %d 不存在\n", patientID);
-        pause();
-        return;
-    }
-    
-    // 检查关联是否已存在
-    if (doctorPatientRelationExists(doctorID, patientID)) {
-        printf("\n? 错误：医生ID %d 与病人ID %d 的关联已存在\n", doctorID, patientID);
-        pause();
-        return;
-    }
-    
-    // 创建新的关联记录
-    struct DoctorPatientRelation* newRelation = (struct DoctorPatientRelation*)malloc(sizeof(struct DoctorPatientRelation));
-    if (newRelation == NULL) {
-        printf("内存分配失败\n");
-        pause();
-        return;
-    }
-    
-    newRelation->doctorID = doctorID;
-    newRelation->patientID = patientID;
-    
-    printf("输入医疗备注: ");
-    scanf(" %[^\n]", newRelation->notes);
-    flushStdin();
-    
-    printf("输入开始负责日期 (格式: YYYY-MM-DD): ");
-    scanf("%s", newRelation->startDate);
-    flushStdin();
-    
-    // 添加到链表
-    newRelation->next = doctorPatientHead;
-    doctorPatientHead = newRelation;
-    
-    printf("\n? 医生-病人关联建立成功！\n");
-    printf("医生ID: %d | 病人ID: %d | 医疗备注: %s | 开始日期: %s\n", 
-           newRelation->doctorID, newRelation->patientID, newRelation->notes, newRelation->startDate);
-    
-    pause();
-}
-
-// 解除医生与病人的关联
-void removePatientFromDoctor() {
-    printOperationTitle("解除医生-病人关联");
-    
-    int doctorID, patientID;
-    
-    printf("输入医生ID: ");
-    scanf("%d", &doctorID);
-    flushStdin();
-    
-    printf("输入病人ID: ");
-    scanf("%d", &patientID);
-    flushStdin();
-    
-    struct DoctorPatientRelation* current = doctorPatientHead;
-    struct DoctorPatientRelation* prev = NULL;
-    
-    while (current != NULL) {
-        if (current->doctorID == doctorID && current->patientID == patientID) {
-            printf("\n将要删除的关联信息：\n");
-            printf("医生ID: %d | 病人ID: %d | 医疗备注: %s | 开始日期: %s\n", 
-                   current->doctorID, current->patientID, current->notes, current->startDate);
-            
-            printf("\n确认删除? (1确认, 0取消): ");
-            int confirm;
-            scanf("%d", &confirm);
-            flushStdin();
-            
-            if (confirm) {
-                if (prev == NULL) {
-                    doctorPatientHead = current->next;
-                } else {
-                    prev->next = current->next;
-                }
-                free(current);
-                printf("\n? 医生-病人关联解除成功\n");
-            } else {
-                printf("\n操作已取消\n");
-            }
-            
-            pause();
-            return;
-        }
-        
-        prev = current;
-        current = current->next;
-    }
-    
-    printf("\n? 未找到医生ID %d 和病人ID %d 的关联记录\n", doctorID, patientID);
-    pause();
-}
-
-// 查询医生负责的所有病人
-void listPatientsByDoctor() {
-    printOperationTitle("查询医生负责的病人");
-    
-    int doctorID;
-    printf("输入医生ID: ");
-    scanf("%d", &doctorID);
-    flushStdin();
-    
-    // 检查医生是否存在
-    if (!doctorExists(doctorID)) {
-        printf("\n? 错误：医生ID %d 不存在\n", doctorID);
-        pause();
-        return;
-    }
-    
-    // 显示医生基本信息
-    struct Doctor* doctor = doctorHead;
-    while (doctor != NULL) {
-        if (doctor->doctorID == doctorID) {
-            printf("\n医生信息：\n");
-            printSeparator();
-            printDoctorBasicInfo(doctor);
-            printf("\n");
-            printSeparator();
-            break;
-        }
-        doctor = doctor->next;
-    }
-    
-    // 显示该医生负责的病人列表
-    printf("\n该医生负责的病人列表：\n");
-    printSeparator();
-    
-    int count = 0;
-    struct DoctorPatientRelation* relation = doctorPatientHead;
-    
-    while (relation != NULL) {
-        if (relation->doctorID == doctorID) {
-            // 查找病人详细信息
-            struct Bed* bed = head;
-            while (bed != NULL) {
-                if (bed->isOccupied && bed->patient.patientID == relation->patientID) {
-                    printf("病人ID: %d | 姓名: %s | 诊断: %s | 床位ID: %d | 病房: %d\n",
-                           bed->patient.patientID, bed->patient.name, bed->patient.diagnosis, 
-                           bed->ID, bed->ward);
-                    printf("医疗备注: %s | 开始负责日期: %s\n",
-                           relation->notes, relation->startDate);
-                    printf("----------------------------------------------------------------\n");
-                    count++;
-                    break;
-                }
-                bed = bed->next;
-            }
-            
-            // 如果在床位中找不到该病人信息，只显示关联信息
-            if (bed == NULL) {
-                printf("病人ID: %d | 医疗备注: %s | 开始负责日期: %s\n",
-                       relation->patientID, relation->notes, relation->startDate);
-                printf("(注: 未找到该病人的详细信息)\n");
-                printf("----------------------------------------------------------------\n");
-                count++;
-            }
-        }
-        relation = relation->next;
-    }
-    
-    if (count == 0) {
-        printf("该医生暂无负责的病人\n");
-    } else {
-        printf("\n? 共找到 %d 条病人记录\n", count);
-    }
-    
-    pause();
-}
-
-// 查询病人的主治医生
-void listDoctorsByPatient() {
-    printOperationTitle("查询病人的医生");
-    
-    int patientID;
-    printf("输入病人ID: ");
-    scanf("%d", &patientID);
-    flushStdin();
-    
-    // 检查病人是否存在
-    if (!patientExists(patientID)) {
-        printf("\n? 错误：病人ID %d 不存在\n", patientID);
-        pause();
-        return;
-    }
-    
-    // 显示病人基本信息
-    struct Bed* bed = head;
-    while (bed != NULL) {
-        if (bed->isOccupied && bed->patient.patientID == patientID) {
-            printf("\n病人信息：\n");
-            printSeparator();
-            printPatientInfo(&bed->patient);
-            printf("\n床位ID: %d | 病房: %d | 科室: ", bed->ID, bed->ward);
-            printDepartment(bed->department);
-            printf("\n");
-            printSeparator();
-            break;
-        }
-        bed = bed->next;
-    }
-    
-    // 显示负责该病人的医生列表
-    printf("\n负责该病人的医生列表：\n");
-    printSeparator();
-    
-    int count = 0;
-    struct DoctorPatientRelation* relation = doctorPatientHead;
-    
-    while (relation != NULL) {
-        if (relation->patientID == patientID) {
-            // 查找医生详细信息
-            struct Doctor* doctor = doctorHead;
-            while (doctor != NULL) {
-                if (doctor->doctorID == relation->doctorID) {
-                    printDoctorBasicInfo(doctor);
-                    printf("\n医疗备注: %s | 开始负责日期: %s\n",
-                           relation->notes, relation->startDate);
-                    printf("----------------------------------------------------------------\n");
-                    count++;
-                    break;
-                }
-                doctor = doctor->next;
-            }
-            
-            // 如果找不到该医生信息，只显示关联信息
-            if (doctor == NULL) {
-                printf("医生ID: %d | 医疗备注: %s | 开始负责日期: %s\n",
-                       relation->doctorID, relation->notes, relation->startDate);
-                printf("(注: 未找到该医生的详细信息)\n");
-                printf("----------------------------------------------------------------\n");
-                count++;
-            }
-        }
-        relation = relation->next;
-    }
-    
-    if (count == 0) {
-        printf("该病人暂无负责的医生\n");
-    } else {
-        printf("\n? 共找到 %d 条医生记录\n", count);
-    }
-    
-    pause();
-}
-
-// 分配病房给医生
-void assignWardToDoctor() {
-    printOperationTitle("分配病房给医生");
-    
-    int doctorID, wardNumber;
-    
-    printf("输入医生ID: ");
-    scanf("%d", &doctorID);
-    flushStdin();
-    
-    // 检查医生是否存在
-    if (!doctorExists(doctorID)) {
-        printf("\n? 错误：医生ID %d 不存在\n", doctorID);
-        pause();
-        return;
-    }
-    
-    printf("输入病房号: ");
-    scanf("%d", &wardNumber);
-    flushStdin();
-    
-    // 检查病房是否存在
-    if (!wardExists(wardNumber)) {
-        printf("\n? 错误：病房号 %d 不存在\n", wardNumber);
-        pause();
-        return;
-    }
-    
-    // 检查关联是否已存在
-    if (doctorWardRelationExists(doctorID, wardNumber)) {
-        printf("\n? 错误：医生ID %d 与病房号 %d 的关联已存在\n", doctorID, wardNumber);
-        pause();
-        return;
-    }
-    
-    // 创建新的关联记录
-    struct DoctorWardRelation* newRelation = (struct DoctorWardRelation*)malloc(sizeof(struct DoctorWardRelation));
-    if (newRelation == NULL) {
-        printf("内存分配失败\n");
-        pause();
-        return;
-    }
-    
-    newRelation->doctorID = doctorID;
-    newRelation->wardNumber = wardNumber;
-    
-    printf("是否为主治医生 (1是, 0否): ");
-    scanf("%d", &newRelation->isHeadDoctor);
-    flushStdin();
-    
-    printf("输入查房安排: ");
-    scanf(" %[^\n]", newRelation->scheduleInfo);
-    flushStdin();
-    
-    // 添加到链表
-    newRelation->next = doctorWardHead;
-    doctorWardHead = newRelation;
-    
-    printf("\n? 医生-病房关联建立成功！\n");
-    printf("医生ID: %d | 病房号: %d | 主治医生: %s | 查房安排: %s\n", 
-           newRelation->doctorID, newRelation->wardNumber, 
-           newRelation->isHeadDoctor ? "是" : "否", newRelation->scheduleInfo);
-    
-    pause();
-}
-
-// 解除医生与病房的关联
-void removeWardFromDoctor() {
-    printOperationTitle("解除医生-病房关联");
-    
-    int doctorID, wardNumber;
-    
-    printf("输入医生ID: ");
-    scanf("%d", &doctorID);
-    flushStdin();
-    
-    printf("输入病房号: ");
-    scanf("%d", &wardNumber);
-    flushStdin();
-    
-    struct DoctorWardRelation* current = doctorWardHead;
-    struct DoctorWardRelation* prev = NULL;
-    
-    while (current != NULL) {
-        if (current->doctorID == doctorID && current->wardNumber == wardNumber) {
-            printf("\n将要删除的关联信息：\n");
-            printf("医生ID: %d | 病房号: %d | 主治医生: %s | 查房安排: %s\n", 
-                   current->doctorID, current->wardNumber, 
-                   current->isHeadDoctor ? "是" : "否", current->scheduleInfo);
-            
-            printf("\n确认删除? (1确认, 0取消): ");
-            int confirm;
-            scanf("%d", &confirm);
-            flushStdin();
-            
-            if (confirm) {
-                if (prev == NULL) {
-                    doctorWardHead = current->next;
-                } else {
-                    prev->next = current->next;
-                }
-                free(current);
-                printf("\n? 医生-病房关联解除成功\n");
-            } else {
-                printf("\n操作已取消\n");
-            }
-            
-            pause();
-            return;
-        }
-        
-        prev = current;
-        current = current->next;
-    }
-    
-    printf("\n? 未找到医生ID %d 和病房号 %d 的关联记录\n", doctorID, wardNumber);
-    pause();
-}
-
-// 查询医生负责的所有病房
-void listWardsByDoctor() {
-    printOperationTitle("查询医生负责的病房");
-    
-    int doctorID;
-    printf("输入医生ID: ");
-    scanf("%d", &doctorID);
-    flushStdin();
-    
-    // 检查医生是否存在
-    if (!doctorExists(doctorID)) {
-        printf("\n? 错误：医生ID %d 不存在\n", doctorID);
-        pause();
-        return;
-    }
-    
-    // 显示医生基本信息
-    struct Doctor* doctor = doctorHead;
-    while (doctor != NULL) {
-        if (doctor->doctorID == doctorID) {
-            printf("\n医生信息：\n");
-            printSeparator();
-            printDoctorBasicInfo(doctor);
-            printf("\n");
-            printSeparator();
-            break;
-        }
-        doctor = doctor->next;
-    }
-    
-    // 显示该医生负责的病房列表
-    printf("\n该医生负责的病房列表：\n");
-    printSeparator();
-    
-    int count = 0;
-    struct DoctorWardRelation* relation = doctorWardHead;
-    
-    while (relation != NULL) {
-        if (relation->doctorID == doctorID) {
-            printf("病房号: %d | 主治医生: %s | 查房安排: %s\n", 
-                   relation->wardNumber, 
-                   relation->isHeadDoctor ? "是" : "否", 
-                   relation->scheduleInfo);
-            
-            // 显示该病房中的床位数量
-            int bedCount = 0;
-            int occupiedCount = 0;
-            struct Bed* bed = head;
-            while (bed != NULL) {
-                if (bed->ward == relation->wardNumber) {
-                    bedCount++;
-                    if (bed->isOccupied) {
-                        occupiedCount++;
-                    }
-                }
-                bed = bed->next;
-            }
-            
-            printf("该病房床位情况: 总床位数: %d | 已占用: %d | 空闲: %d\n", 
-                   bedCount, occupiedCount, bedCount - occupiedCount);
-            printf("----------------------------------------------------------------\n");
-            count++;
-        }
-        relation = relation->next;
-    }
-    
-    if (count == 0) {
-        printf("该医生暂无负责的病房\n");
-    } else {
-        printf("\n? 共找到 %d 条病房记录\n", count);
-    }
-    
-    pause();
-}
-
-// 查询病房的所有医生
-void listDoctorsByWard() {
-    printOperationTitle("查询病房的医生");
-    
-    int wardNumber;
-    printf("输入病房号: ");
-    scanf("%d", &wardNumber);
-    flushStdin();
-    
-    // 检查病房是否存在
-    if (!wardExists(wardNumber)) {
-        printf("\n? 错误：病房号 %d 不存在\n", wardNumber);
-        pause();
-        return;
-    }
-    
-    // 显示病房基本信息
-    int bedCount = 0;
-    int occupiedCount = 0;
-    int department = 0;
-    struct Bed* bed = head;
-    while (bed != NULL) {
-        if (bed->ward == wardNumber) {
-            bedCount++;
-            if (bed->isOccupied) {
-                occupiedCount++;
-            }
-            department = bed->department; // 假设同一病房的科室相同
-        }
-        bed = bed->next;
-    }
-    
-    printf("\n病房信息：\n");
-    printSeparator();
-    printf("病房号: %d | 科室: ", wardNumber);
-    printDepartment(department);
-    printf(" | 总床位数: %d | 已占用: %d | 空闲: %d\n", 
-           bedCount, occupiedCount, bedCount - occupiedCount);
-    printSeparator();
-    
-    // 显示负责该病房的医生列表
-    printf("\n负责该病房的医生列表：\n");
-    printSeparator();
-    
-    int count = 0;
-    struct DoctorWardRelation* relation = doctorWardHead;
-    
-    while (relation != NULL) {
-        if (relation->wardNumber == wardNumber) {
-            // 查找医生详细信息
-            struct Doctor* doctor = doctorHead;
-            while (doctor != NULL) {
-                if (doctor->doctorID == relation->doctorID) {
-                    printDoctorBasicInfo(doctor);
-                    printf("\n主治医生: %s | 查房安排: %s\n",
-                           relation->isHeadDoctor ? "是" : "否", 
-                           relation->scheduleInfo);
-                    printf("----------------------------------------------------------------\n");
-                    count++;
-                    break;
-                }
-                doctor = doctor->next;
-            }
-            
-            // 如果找不到该医生信息，只显示关联信息
-            if (doctor == NULL) {
-                printf("医生ID: %d | 主治医生: %s | 查房安排: %s\n",
-                       relation->doctorID, 
-                       relation->isHeadDoctor ? "是" : "否", 
-                       relation->scheduleInfo);
-                printf("(注: 未找到该医生的详细信息)\n");
-                printf("----------------------------------------------------------------\n");
-                count++;
-            }
-        }
-        relation = relation->next;
-    }
-    
-    if (count == 0) {
-        printf("该病房暂无负责的医生\n");
-    } else {
-        printf("\n? 共找到 %d 条医生记录\n", count);
-    }
-    
-    pause();
-}
-
-int main() {
-    int choice;
-    
-    // 尝试加载数据文件 (改为CSV格式)
-    loadBedsFromFile("beds.csv");
-    loadDoctorsFromFile("doctors.csv");
-    loadDoctorPatientFromFile("doctor_patient.csv");
-    loadDoctorWardFromFile("doctor_ward.csv");
-    
-    // 主循环
-    while (1) {
-        // 显示菜单
-        printMenu();
-        
-        // 获取用户选择
-        if (scanf("%d", &choice) != 1) {
-            printf("? 无效的输入，请输入数字选项\n");
-            flushStdin();
-            printf("\n按回车键继续...");
-            getchar();
-            continue;
-        }
-        flushStdin(); // 清空输入缓冲区
-        
-        // 处理用户选择
-        switch (choice) {
-        case 1:
-            registerPatient();
-            break;
-        case 2:
-            assignBed();
-            break;
-        case 3:
-            dischargePatient();
-            break;
-        case 4:
-            addBed();
-            break;
-        case 5:
-            modifyBed();
-            break;
-        case 6:
-            deleteBed();
-            break;
-        case 7:
-            searchBedByID();
-            break;
-        case 8:
-            listAllBeds();
-            break;
-        case 9:
-            listAvailableBeds();
-            break;
-        case 10:
-            filterBedsByType();
-            break;
-        case 11:
-            filterBedsByWard();
-            break;
-        case 12:
-            filterBedsByDepartment();
-            break;
-        case 13:
-            sortBedsByID();
-            break;
-        case 14:
-            addDoctor();
-            break;
-        case 15:
-            modifyDoctor();
-            break;
-        case 16:
-            deleteDoctor();
-            break;
-        case 17:
-            searchDoctorByID();
-            break;
-        case 18:
-            listAllDoctors();
-            break;
-        case 19:
-            assignPatientToDoctor();
-            break;
-        case 20:
-            assignWardToDoctor();
-            break;
-        case 21:
-            listPatientsByDoctor();
-            break;
-        case 22:
-            listWardsByDoctor();
-            break;
-        case 24:
-            saveBedsToFile("beds.csv"); // 保存为CSV格式
-            saveDoctorsToFile("doctors.csv");
-            saveDoctorPatientToFile("doctor_patient.csv");
-            saveDoctorWardToFile("doctor_ward.csv");
-            printf("感谢使用医院床位管理系统，再见！\n");
-            cleanupMemory();
-            exit(0);
-        default:
-            printf("? 无效的选项，请输入有效的菜单选项\n");
-            printf("\n按回车键继续...");
-            getchar();
-            break;
-        }
-    }
-    
-    return 0;
+#define  _CRT_SECURE_NO_WARNINGS
+#ifndef _WIN32
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L // -std=c11下fseeko/ftello等POSIX函数须显式启用才有声明
+#endif
+#define _FILE_OFFSET_BITS 64   // 32位系统上同样支持超过2GB的数据文件
+#endif
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+// 内存映射文件 (二进制快照) 和线程 (并行加载、后台检查点)
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// x86平台的SIMD指令与CPU特性检测
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define HBM_X86 1
+#define TARGET_AVX2
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HBM_X86 1
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// 病人信息结构
+struct Patient {
+    int patientID;      // 病人ID
+    char name[50];      // 姓名
+    int gender;         // 性别
+    char phone[20];     // 电话
+    char diagnosis[100]; // 诊断结果
+    int age;            // 年龄
+};
+
+enum BedType {
+    RegularBed = 0,     // 普通床位
+    ICUBed,             // 重症监护床位
+    EmergencyBed        // 急诊床位
+};
+
+struct Bed {
+    int ID;             // 床位ID
+    int isOccupied;     // 是否已分配
+    int hasOxygen;      // 是否有供氧设备
+    enum BedType bedType; // 床位类型
+    int ward;           // 病房号
+    int department;     // 科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他)
+    struct Patient patient; // 病人信息
+    struct Bed* next;   // 链表指针
+    struct Bed* prev;   // 前驱指针 (用于O(1)删除)
+    int slot;           // 在列存储中的位置
+    int heapPos[2];     // 在空闲床位堆中的位置 (0-全院分类堆, 1-病房分类堆)
+};
+
+// 医生结构体定义
+struct Doctor {
+    int doctorID;           // 医生ID
+    char name[50];          // 姓名
+    int gender;             // 性别（1-男，0-女）
+    char phone[20];         // 联系电话
+    int department;         // 所属科室（与床位科室编码一致：1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他）
+    char specialization[50]; // 专业/专长
+    int qualification;      // 职称（1-住院医师, 2-主治医师, 3-副主任医师, 4-主任医师）
+    char officeLocation[30]; // 办公室位置
+    struct Doctor* next;    // 链表指针
+    struct Doctor* prev;    // 前驱指针 (用于O(1)删除)
+    int caseload;           // 当前负责的病人数量
+    int loadPos;            // 在科室负载堆中的位置
+};
+
+// 医生-病人关联结构体
+struct DoctorPatientRelation {
+    int doctorID;            // 医生ID
+    int patientID;           // 病人ID
+    char notes[100];         // 医疗备注
+    char startDate[20];      // 开始负责日期
+    struct DoctorPatientRelation* next; // 链表指针
+    struct DoctorPatientRelation* prev; // 前驱指针 (用于O(1)删除)
+    int edgePos[2];          // 在邻接索引段中的位置 (0-按医生, 1-按病人)
+};
+
+// 医生-病房关联结构体
+struct DoctorWardRelation {
+    int doctorID;            // 医生ID
+    int wardNumber;          // 病房号
+    int isHeadDoctor;        // 是否为主治医生（1-是，0-否）
+    char scheduleInfo[100];  // 查房安排
+    struct DoctorWardRelation* next; // 链表指针
+    struct DoctorWardRelation* prev; // 前驱指针 (用于O(1)删除)
+    int edgePos[2];          // 在邻接索引段中的位置 (0-按医生, 1-按病房)
+};
+
+// 自动分配床位的约束条件
+struct BedRequest {
+    int bedType;        // 需要的床位类型
+    int department;     // 需要的科室
+    int needOxygen;     // 是否需要供氧设备
+    int preferredWard;  // 优先病房号, 0表示无偏好
+};
+
+// 病人登记表记录: 每个在院病人一条, 无论是否已分配床位
+struct PatientRecord {
+    struct Patient patient;         // 病人信息 (已分配床位时床位中保存同一份副本)
+    struct Bed* bed;                // 当前所在床位, NULL表示尚未分配床位
+    struct PatientRecord* next;     // 链表指针
+    struct PatientRecord* prev;     // 前驱指针 (用于O(1)删除)
+    int acuity;                     // 病情分级 (1-危重 ... 5-非紧急), 0表示不在候床队列
+    struct BedRequest request;      // 候床需求
+    long long waitSince;            // 开始候床的时间 (秒)
+    long long waitSeq;              // 入队序号, 同级病人先到先得
+    int waitPos;                    // 在候床堆中的位置
+};
+
+// 全局链表头指针
+struct Bed* head = NULL;
+struct Doctor* doctorHead = NULL;
+struct DoctorPatientRelation* doctorPatientHead = NULL;
+struct DoctorWardRelation* doctorWardHead = NULL;
+struct PatientRecord* patientHead = NULL;
+
+// 定长对象内存池: 按块(slab)批量分配, 删除的对象进入空闲链表复用, 退出时整块释放
+struct SlabHeader {
+    struct SlabHeader* next;    // 下一个块
+    size_t capacity;            // 本块可容纳的对象数量 (同时保证对象区按指针大小对齐)
+};
+
+struct SlabPool {
+    size_t objectSize;          // 对象大小
+    int nextSlabObjects;        // 下一个块的对象数量, 按倍数增长
+    struct SlabHeader* slabs;   // 已分配的块链表
+    char* cursor;               // 当前块中下一个未使用的对象
+    char* limit;                // 当前块的末尾
+    void* freeList;             // 已释放对象链表, 对象首部存放后继指针
+};
+
+#define SLAB_MIN_OBJECTS 64
+#define SLAB_MAX_OBJECTS 65536
+
+#define SLAB_POOL_INIT(type) {sizeof(type) > sizeof(void*) ? sizeof(type) : sizeof(void*), SLAB_MIN_OBJECTS, NULL, NULL, NULL, NULL}
+
+struct SlabPool bedPool = SLAB_POOL_INIT(struct Bed);
+struct SlabPool doctorPool = SLAB_POOL_INIT(struct Doctor);
+struct SlabPool doctorPatientPool = SLAB_POOL_INIT(struct DoctorPatientRelation);
+struct SlabPool doctorWardPool = SLAB_POOL_INIT(struct DoctorWardRelation);
+struct SlabPool patientPool = SLAB_POOL_INIT(struct PatientRecord);
+
+// 床位ID哈希索引 (开放寻址, 线性探测)
+struct BedIndex {
+    struct Bed** slots;  // 桶数组, NULL表示空桶
+    int capacity;        // 桶数量 (始终为2的幂)
+    int count;           // 已索引的床位数量
+};
+
+struct BedIndex bedIndex = {NULL, 0, 0};
+
+// 病人ID哈希索引 (开放寻址, 线性探测), 指向病人登记表记录
+struct PatientIndex {
+    struct PatientRecord** slots;   // 桶数组, NULL表示空桶
+    int capacity;                   // 桶数量 (始终为2的幂)
+    int count;                      // 已索引的病人数量
+};
+
+struct PatientIndex patientIndex = {NULL, 0, 0};
+
+// 医生ID哈希索引 (开放寻址, 线性探测)
+struct DoctorIndex {
+    struct Doctor** slots;      // 桶数组, NULL表示空桶
+    int capacity;               // 桶数量 (始终为2的幂)
+    int count;                  // 已索引的医生数量
+};
+
+struct DoctorIndex doctorIndex = {NULL, 0, 0};
+
+// 关联关系的邻接索引 (CSR布局): 同一个键 (医生ID/病人ID/病房号) 的关系指针在edges中连续存放.
+// 段满时搬到edges末尾并加倍容量, 搬迁留下的空洞过多时整体压缩; 加载数据后压缩为紧凑布局
+struct AdjacencySegment {
+    int key;
+    int used;           // 桶是否已占用
+    int offset;         // 在edges中的起始位置
+    int count;          // 该键的关系数量
+    int capacity;       // 该段占用的位置数
+};
+
+struct AdjacencyIndex {
+    struct AdjacencySegment* segments;  // 按键散列的开放寻址表
+    int segmentCapacity;                // 桶数量 (始终为2的幂)
+    int segmentCount;
+    void** edges;                       // 各段共用的关系指针数组
+    int edgeCount;                      // 已分配给各段的位置数 (含空洞)
+    int edgeCapacity;
+    int wasted;                         // 搬迁留下的空洞数
+    size_t posOffset;                   // 关系结构体中记录段内位置的int字段偏移, 用于O(1)删除
+};
+
+#define ADJACENCY_INIT(type, side) {NULL, 0, 0, NULL, 0, 0, 0, offsetof(type, edgePos) + (side) * sizeof(int)}
+
+struct AdjacencyIndex doctorPatientByDoctor = ADJACENCY_INIT(struct DoctorPatientRelation, 0);  // 医生ID -> 医生-病人关联
+struct AdjacencyIndex doctorPatientByPatient = ADJACENCY_INIT(struct DoctorPatientRelation, 1); // 病人ID -> 医生-病人关联
+struct AdjacencyIndex doctorWardByDoctor = ADJACENCY_INIT(struct DoctorWardRelation, 0);        // 医生ID -> 医生-病房关联
+struct AdjacencyIndex doctorWardByWard = ADJACENCY_INIT(struct DoctorWardRelation, 1);          // 病房号 -> 医生-病房关联
+
+// 关联关系的复合键哈希集合 (开放寻址, 线性探测): 键为 (医生ID, 病人ID/病房号), 用于O(1)查重
+struct RelationSlot {
+    unsigned long long key;
+    void* relation;     // NULL表示空桶
+};
+
+struct RelationSet {
+    struct RelationSlot* slots;
+    int capacity;       // 桶数量 (始终为2的幂)
+    int count;
+};
+
+struct RelationSet doctorPatientPairs;  // (医生ID, 病人ID) -> 医生-病人关联
+struct RelationSet doctorWardPairs;     // (医生ID, 病房号) -> 医生-病房关联
+
+// 病人姓名/诊断的n元组倒排索引: 按UTF-8字符切分, 每个位置索引1、2、3元组,
+// 字段开头另加一个起始标记以支持前缀查询. 键中打包了字段编号和至多3个字符
+struct GramPosting {
+    unsigned long long key;         // 0表示空桶
+    struct PatientRecord** items;   // 包含该元组的病人 (每人至多出现一次)
+    int count;
+    int capacity;
+};
+
+struct TextIndex {
+    struct GramPosting* slots;  // 开放寻址桶数组
+    int capacity;               // 桶数量 (始终为2的幂)
+    int count;                  // 已使用的桶数量
+    int incomplete;             // 内存不足导致索引缺失时置1, 查询退化为顺序扫描
+};
+
+#define TEXT_FIELD_NAME 0
+#define TEXT_FIELD_DIAGNOSIS 1
+#define TEXT_GRAM_BEGIN 1       // 字段起始标记 (不会出现在正常文本中的码点)
+#define TEXT_MAX_CHARS 100      // 单个字段最多的字符数 (诊断字段为100字节)
+
+struct TextIndex textIndex = {NULL, 0, 0, 0};
+
+// 电话号码基数树 (路径压缩): 正序树支持前缀查询, 逆序树支持尾号查询
+// 病人和医生的号码放在同一棵树中, 条目记录所属人的类型
+#define PHONE_KEY_MAX 20        // 电话字段长度 (含结尾的'\0')
+#define PHONE_QUERY_LIMIT 50    // 单次查询最多返回的条目数
+
+enum PhoneOwnerKind {
+    PhoneOwnerPatient = 0,      // owner指向struct PatientRecord
+    PhoneOwnerDoctor            // owner指向struct Doctor
+};
+
+struct PhoneEntry {
+    int kind;                   // 所属人类型
+    void* owner;                // 所属人记录
+    struct PhoneEntry* next;
+};
+
+struct PhoneTrieNode {
+    char label[PHONE_KEY_MAX];      // 父节点到本节点的边上的字符
+    int labelLength;
+    int count;                      // 子树中的条目总数, 查询时无需遍历即可得到结果数量
+    struct PhoneTrieNode* child;    // 第一个子节点
+    struct PhoneTrieNode* sibling;  // 下一个兄弟节点 (按首字符升序)
+    struct PhoneEntry* entries;     // 号码恰好在本节点结束的条目
+};
+
+struct PhoneTrieNode phonePrefixRoot;   // 按号码正序
+struct PhoneTrieNode phoneSuffixRoot;   // 按号码逆序
+
+struct SlabPool phoneNodePool = SLAB_POOL_INIT(struct PhoneTrieNode);
+struct SlabPool phoneEntryPool = SLAB_POOL_INIT(struct PhoneEntry);
+
+// 床位ID有序索引 (跳表), 插入删除时保持有序, 支持按ID范围查询
+#define SKIPLIST_MAX_LEVEL 24
+
+struct BedSkipNode {
+    struct Bed* bed;
+    int level;                          // 该节点的层数
+    struct BedSkipNode* forward[];      // 每层的后继节点
+};
+
+struct BedOrderIndex {
+    struct BedSkipNode* header;         // 哨兵节点, 拥有最大层数
+    int level;                          // 当前使用的最高层数
+    unsigned int seed;                  // 随机层数生成器状态
+};
+
+struct BedOrderIndex bedOrder = {NULL, 1, 2463534242u};
+
+// 床位热数据列存储 (结构数组)
+// 筛选类查询只扫描这些紧凑的列, 命中后才通过record访问完整床位记录(含病人信息等冷数据)
+struct BedColumns {
+    int* ID;                    // 床位ID
+    unsigned char* isOccupied;  // 是否已分配
+    unsigned char* hasOxygen;   // 是否有供氧设备
+    unsigned char* bedType;     // 床位类型 (超出范围时为BED_CODE_OTHER)
+    int* ward;                  // 病房号
+    unsigned char* department;  // 科室编号 (超出范围时为BED_CODE_OTHER)
+    struct Bed** record;        // 完整床位记录
+    int count;                  // 已用槽位数量
+    int capacity;               // 已分配槽位数量
+};
+
+#define BED_CODE_OTHER 255      // 列中无法用一个字节表示的取值
+
+struct BedColumns bedColumns = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0};
+
+#define BED_TYPE_COUNT 3        // 床位类型数量 (RegularBed, ICUBed, EmergencyBed)
+#define DEPARTMENT_COUNT 5      // 科室数量 (编号1-5)
+
+// 床位计数器
+struct BedCounter {
+    int total;                  // 床位总数
+    int occupied;               // 已占用床位数
+};
+
+// 空闲床位最小堆 (按床位ID), 支持按位置删除
+struct BedHeap {
+    struct Bed** items;
+    int count;
+    int capacity;
+};
+
+// 空闲床位按 (床位类型, 科室, 是否供氧) 分类, 下标与byType/byDepartment位图一致
+#define FREE_CLASS_COUNT ((BED_TYPE_COUNT + 1) * (DEPARTMENT_COUNT + 1) * 2)
+
+// 病房索引项: 成员位图、计数和分类空闲床位堆
+struct WardIndex {
+    int ward;                   // 病房号
+    unsigned long long* members; // 属于该病房的槽位
+    struct BedCounter counter;  // 该病房的床位计数
+    struct BedHeap freeBeds[FREE_CLASS_COUNT]; // 该病房内各分类的空闲床位
+};
+
+// 床位位图索引 (按列存储的槽位编号)
+// 空闲床位 = 成员位图 & ~占用位图, 计数通过popcount完成, 无需遍历床位
+struct BedBitmaps {
+    unsigned long long* occupied;                              // 占用位图
+    unsigned long long* byType[BED_TYPE_COUNT + 1];            // 每种床位类型, 最后一项为其他取值
+    unsigned long long* byDepartment[DEPARTMENT_COUNT + 1];    // 科室1-5, 下标0为其他取值
+    struct WardIndex* wards;    // 病房索引项数组
+    int wardCount;
+    int wardCapacity;
+    int* wardSlots;             // 病房号到wards下标的开放寻址表, 存储下标+1, 0表示空
+    int wardSlotCapacity;
+    int wordCapacity;           // 每个位图的64位字数量
+};
+
+struct BedBitmaps bedBitmaps;
+
+// 增量维护的床位统计, 床位增删改、分配和出院时O(1)更新
+struct BedStats {
+    struct BedCounter all;                                  // 全院合计
+    struct BedCounter byType[BED_TYPE_COUNT + 1];           // 下标与byType位图一致
+    struct BedCounter byDepartment[DEPARTMENT_COUNT + 1];   // 下标与byDepartment位图一致
+};
+
+struct BedStats bedStats;
+
+// 全院各分类的空闲床位堆, 供自动分配使用
+struct BedHeap freeBedHeaps[FREE_CLASS_COUNT];
+
+// 候床队列: 按需求分类 (与空闲床位分类下标一致) 的最小堆, 病情越重、等待越久越靠前
+struct WaitHeap {
+    struct PatientRecord** items;
+    int count;
+    int capacity;
+};
+
+#define ACUITY_LEVELS 5         // 病情分级数量
+
+struct WaitHeap waitHeaps[FREE_CLASS_COUNT];
+long long waitSeqNext = 1;      // 下一个入队序号
+int waitCount = 0;              // 候床病人总数
+
+// 各科室医生的负载最小堆 (下标与byDepartment位图一致), 堆顶为负责病人最少的医生, 供自动分配使用
+struct DoctorLoadHeap {
+    struct Doctor** items;
+    int count;
+    int capacity;
+};
+
+struct DoctorLoadHeap doctorLoadHeaps[DEPARTMENT_COUNT + 1];  // 科室1-5, 下标0为其他取值
+int doctorLoadWeighted = 0;                                   // 是否按职称加权 (职称越高可负责的病人越多)
+
+// 组合筛选条件, 取值为-1表示不限
+struct BedFilter {
+    int bedType;
+    int ward;
+    int department;
+    int hasOxygen;
+};
+
+// 定长记录 (不含指针, 字符串字段保存完整的定长数组), 用于快照、床位检查点文件、操作日志和检查点副本
+struct SnapshotBed {
+    int ID;
+    int isOccupied;
+    int hasOxygen;
+    int bedType;
+    int ward;
+    int department;
+    struct Patient patient;
+};
+
+struct SnapshotPatient {
+    struct Patient patient;
+    int acuity;
+    struct BedRequest request;
+    long long waitSince;
+    long long waitSeq;
+};
+
+struct SnapshotDoctor {
+    int doctorID;
+    char name[50];
+    int gender;
+    char phone[20];
+    int department;
+    char specialization[50];
+    int qualification;
+    char officeLocation[30];
+};
+
+struct SnapshotDoctorPatient {
+    int doctorID;
+    int patientID;
+    char notes[100];
+    char startDate[20];
+};
+
+struct SnapshotDoctorWard {
+    int doctorID;
+    int wardNumber;
+    int isHeadDoctor;
+    char scheduleInfo[100];
+};
+
+// 操作日志的记录类型 (日志的读写见快照之后)
+#define JOURNAL_FILE "hospital.journal"
+#define JOURNAL_MAGIC "HBMJRNL"     // 含结尾的'\0'共8字节
+#define JOURNAL_VERSION 1
+
+// 每张数据表占两个连续的类型 (修改/删除), 顺序与enum DataTable一致
+enum JournalRecordType {
+    JournalBedPut = 1,
+    JournalBedDelete,
+    JournalPatientPut,          // 未分配床位的登记病人 (在院病人的状态随床位记录)
+    JournalPatientDelete,
+    JournalDoctorPut,
+    JournalDoctorDelete,
+    JournalDoctorPatientPut,
+    JournalDoctorPatientDelete,
+    JournalDoctorWardPut,
+    JournalDoctorWardDelete
+};
+
+// 数据表, 与CSV文件一一对应
+enum DataTable {
+    TableBeds,
+    TablePatients,
+    TableDoctors,
+    TableDoctorPatient,
+    TableDoctorWard,
+    TABLE_COUNT
+};
+
+const char* const tableFiles[TABLE_COUNT] = {"beds.csv", "patients.csv", "doctors.csv", "doctor_patient.csv", "doctor_ward.csv"};
+
+// 各表的修改代数: 每次修改加1, 保存成功后记下保存时的代数, 两者相同的表无需重新写入
+unsigned long long tableGeneration[TABLE_COUNT];
+unsigned long long tableSavedGeneration[TABLE_COUNT];
+
+// 床位检查点文件按槽位分页保存定长记录, 保存时只重写修改过的页 (文件读写见快照之后)
+#define BED_PAGE_RECORDS 256    // 每页的记录数, 也是脏标记和校验的粒度
+
+struct BedFileState {
+    long long checkpoint;           // 文件中最近一次保存的检查点编号, 0表示文件与内存不同步, 下次需整体重写
+    int capacity;                   // 文件中的记录槽位数
+    unsigned long long* dirtyPages; // 上次保存后被修改过的页
+    int dirtyWords;
+    int pagesLost;                  // 内存不足时未能记录脏页, 下次整体重写
+};
+
+struct BedFileState bedFile = {0, 0, NULL, 0, 0};
+
+// 数据表在检查点时刻的副本 (定长记录数组), 检查点在锁外从副本写入文件
+struct TableCopy {
+    void* records;
+    int* order;                 // 按链表顺序排列的记录下标, NULL表示按数组顺序
+    int count;
+};
+
+// 一次检查点: 复制 (持有存储锁) -> 写入文件 (不持有锁) -> 登记结果 (持有存储锁)
+struct Checkpoint {
+    int quiet;                  // 后台检查点只报告失败
+    int save[TABLE_COUNT];      // 需要重写的CSV文件
+    int saved[TABLE_COUNT];     // 已成功重写
+    unsigned long long generation[TABLE_COUNT]; // 复制时各表的修改代数
+    struct TableCopy tables[TABLE_COUNT];       // 床位按槽位顺序; records为NULL表示未复制
+    unsigned long long* dirtyPages; // 复制时床位检查点文件中被修改过的页
+    int dirtyWords;
+    long long bedCheckpoint;    // 复制时床位检查点文件的检查点编号和容量
+    int bedCapacity;
+    int live;                   // 实时模式: 床位检查点文件已在每次提交时写入, 检查点不再写入
+    int bedSaved;               // 床位检查点文件已写入, 新的编号和容量如下
+    long long newBedCheckpoint;
+    int newBedCapacity;
+    long long journalOffset;    // 复制时操作日志的长度, 之前的记录都已包含在副本中
+    int complete;               // CSV、床位检查点文件和快照都已写入
+};
+
+int cpuHasAvx2 = 0;             // 运行时检测, 决定筛选内核使用AVX2还是标量实现
+
+// 函数前向声明
+void listAllBeds();
+void listAvailableBeds();
+void listAvailableBedsLocal();
+
+// 医生管理函数声明
+void addDoctor();
+void modifyDoctor();
+void deleteDoctor();
+void searchDoctorByID();
+void listAllDoctors();
+void assignPatientToDoctor();
+void removePatientFromDoctor();
+void listPatientsByDoctor();
+void listDoctorsByPatient();
+void assignWardToDoctor();
+void removeWardFromDoctor();
+void listWardsByDoctor();
+void listDoctorsByWard();
+int adjacencyDegree(const struct AdjacencyIndex* index, int key);
+
+// 操作日志 (定义见快照之后), 日志未打开时均为空操作
+void journalBed(const struct Bed* bed);
+void journalPatient(const struct PatientRecord* patient);
+void journalDoctor(const struct Doctor* doctor);
+void journalDoctorPatient(const struct DoctorPatientRelation* relation);
+void journalDoctorWard(const struct DoctorWardRelation* relation);
+void journalDelete(int type, int id, int otherID);
+void journalCommit();
+
+// 为内存池新增一个可容纳objects个对象的块
+int slabGrow(struct SlabPool* pool, int objects) {
+    struct SlabHeader* slab = (struct SlabHeader*)malloc(sizeof(struct SlabHeader) + (size_t)objects * pool->objectSize);
+    if (slab == NULL) {
+        return 0;
+    }
+    slab->next = pool->slabs;
+    slab->capacity = (size_t)objects;
+    pool->slabs = slab;
+    pool->cursor = (char*)(slab + 1);
+    pool->limit = pool->cursor + (size_t)objects * pool->objectSize;
+    return 1;
+}
+
+// 从内存池分配一个对象, 失败返回NULL
+void* slabAlloc(struct SlabPool* pool) {
+    if (pool->freeList != NULL) {
+        void* object = pool->freeList;
+        pool->freeList = *(void**)object;
+        return object;
+    }
+    if (pool->cursor == pool->limit) {
+        if (!slabGrow(pool, pool->nextSlabObjects)) {
+            return NULL;
+        }
+        if (pool->nextSlabObjects < SLAB_MAX_OBJECTS) {
+            pool->nextSlabObjects *= 2;
+        }
+    }
+    void* object = pool->cursor;
+    pool->cursor += pool->objectSize;
+    return object;
+}
+
+// 将对象归还内存池
+void slabFree(struct SlabPool* pool, void* object) {
+    if (object == NULL) {
+        return;
+    }
+    *(void**)object = pool->freeList;
+    pool->freeList = object;
+}
+
+// 预留至少objects个对象的连续空间, 用于批量加载前一次性分配
+int slabReserve(struct SlabPool* pool, int objects) {
+    size_t remaining = (size_t)(pool->limit - pool->cursor) / pool->objectSize;
+    if (objects <= 0 || remaining >= (size_t)objects) {
+        return 1;
+    }
+    // 当前块剩余的对象放入空闲链表, 避免浪费
+    while (pool->cursor != pool->limit) {
+        slabFree(pool, pool->cursor);
+        pool->cursor += pool->objectSize;
+    }
+    return slabGrow(pool, objects);
+}
+
+// 把另一个内存池 (对象大小相同) 的全部块并入本内存池, 其中已分配的对象此后归本内存池管理;
+// 来源中未使用的对象放入本内存池的空闲链表, 来源变为空内存池
+void slabAdopt(struct SlabPool* pool, struct SlabPool* from) {
+    while (from->cursor != from->limit) {
+        slabFree(pool, from->cursor);
+        from->cursor += from->objectSize;
+    }
+    while (from->freeList != NULL) {
+        void* object = from->freeList;
+        from->freeList = *(void**)object;
+        slabFree(pool, object);
+    }
+    if (from->slabs != NULL) {
+        struct SlabHeader* last = from->slabs;
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        last->next = pool->slabs;
+        pool->slabs = from->slabs;
+    }
+    from->slabs = NULL;
+    from->cursor = NULL;
+    from->limit = NULL;
+}
+
+// 释放内存池的所有块
+void slabRelease(struct SlabPool* pool) {
+    struct SlabHeader* slab = pool->slabs;
+    while (slab != NULL) {
+        struct SlabHeader* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    pool->slabs = NULL;
+    pool->cursor = NULL;
+    pool->limit = NULL;
+    pool->freeList = NULL;
+    pool->nextSlabObjects = SLAB_MIN_OBJECTS;
+}
+
+// 获取文件大小 (支持超过2GB的文件)
+long long fileSizeOf(FILE* file) {
+#ifdef _WIN32
+    long long current = _ftelli64(file);
+    _fseeki64(file, 0, SEEK_END);
+    long long size = _ftelli64(file);
+    _fseeki64(file, current, SEEK_SET);
+#else
+    long long current = (long long)ftello(file);
+    fseeko(file, 0, SEEK_END);
+    long long size = (long long)ftello(file);
+    fseeko(file, (off_t)current, SEEK_SET);
+#endif
+    return size;
+}
+
+// 移动到文件中的指定位置 (支持超过2GB的文件), 成功返回0
+int fileSeek(FILE* file, long long offset) {
+#ifdef _WIN32
+    return _fseeki64(file, offset, SEEK_SET);
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+// 将已fflush的文件内容刷到磁盘, 成功返回0
+int fileSync(FILE* file) {
+#ifdef _WIN32
+    return _commit(_fileno(file));
+#else
+    return fsync(fileno(file));
+#endif
+}
+
+// 原子替换文件: 先写入"<文件名>.tmp", 刷到磁盘后再改名覆盖原文件, 写入中途崩溃时原文件保持完整.
+// 打开临时文件 (tempName至少260字节), 失败时输出提示并返回NULL
+FILE* atomicFileOpen(const char* filename, char* tempName, const char* mode) {
+    snprintf(tempName, 260, "%s.tmp", filename);
+    FILE* file = fopen(tempName, mode);
+    if (file == NULL) {
+        printf("无法打开文件 %s\n", tempName);
+    }
+    return file;
+}
+
+// 完成写入并替换原文件; failed非0或任何一步失败时删除临时文件, 原文件不变. 成功返回1
+int atomicFileCommit(FILE* file, const char* tempName, const char* filename, int failed) {
+    if (ferror(file) || fflush(file) != 0 || fileSync(file) != 0) {
+        failed = 1;
+    }
+    if (fclose(file) != 0) {
+        failed = 1;
+    }
+    if (failed) {
+        printf("写入文件 %s 失败\n", tempName);
+        remove(tempName);
+        return 0;
+    }
+#ifdef _WIN32
+    // Windows上rename不能覆盖已有文件, MoveFileEx可以原子地替换
+    int renamed = MoveFileExA(tempName, filename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    int renamed = rename(tempName, filename) == 0;
+#endif
+    if (!renamed) {
+        printf("无法替换文件 %s\n", filename);
+        remove(tempName);
+        return 0;
+    }
+    return 1;
+}
+
+// 分块流式读取文本行: 使用固定大小的缓冲区, 内存占用与文件大小无关.
+// 可以只读取文件中的一段 (起始位置须为行首), 用于并行解析同一文件的不同部分
+#define LINE_READER_BUFFER (1 << 20)    // 读缓冲区大小, 也是单行的最大长度
+
+struct LineReader {
+    FILE* file;
+    char* buffer;               // 读缓冲区 (多1字节用于末行的结束符)
+    size_t start;               // 未处理数据的起始位置
+    size_t end;                 // 未处理数据的结束位置
+    int eof;                    // 文件已读完
+    int skipping;               // 正在丢弃超长行的剩余部分
+    int lineTooLong;            // 刚返回的行超长, 内容已丢弃
+    int readError;              // 读取出错, 之后的内容不再读取
+    long long remaining;        // 读取范围内尚未读取的字节数
+    long long bytesRead;        // 已从文件读取的字节数
+    long long lineNumber;       // 已读取的行数 (从读取范围的起始位置算起)
+    long long overlongLines;    // 因超长被跳过的行数
+};
+
+// 打开文件, 从offset处开始逐行读取length个字节 (length为-1时读到文件末尾), 失败返回0
+int lineReaderOpen(struct LineReader* reader, const char* filename, long long offset, long long length) {
+    memset(reader, 0, sizeof(*reader));
+    reader->file = fopen(filename, "rb");
+    if (reader->file == NULL) {
+        return 0;
+    }
+    reader->buffer = (char*)malloc(LINE_READER_BUFFER + 1);
+    if (reader->buffer == NULL || (offset > 0 && fileSeek(reader->file, offset) != 0)) {
+        free(reader->buffer);
+        fclose(reader->file);
+        reader->file = NULL;
+        reader->buffer = NULL;
+        return 0;
+    }
+    reader->remaining = length >= 0 ? length : LLONG_MAX;
+    return 1;
+}
+
+void lineReaderClose(struct LineReader* reader) {
+    if (reader->file != NULL) {
+        fclose(reader->file);
+    }
+    free(reader->buffer);
+    reader->file = NULL;
+    reader->buffer = NULL;
+}
+
+// 读取下一行, 返回以'\0'结尾的行(不含换行符, 指向内部缓冲区), 读取范围结束返回NULL.
+// 超过缓冲区大小的行不会被截断成多条记录, 而是以空行返回并置lineTooLong;
+// 读取出错时置readError并按文件结束处理. 读取器不输出信息, 由调用者报告
+char* lineReaderNext(struct LineReader* reader, size_t* length) {
+    reader->lineTooLong = 0;
+    while (1) {
+        char* lineStart = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+        char* newline = (char*)memchr(lineStart, '\n', available);
+
+        if (newline != NULL || (reader->eof && (available > 0 || reader->skipping))) {
+            size_t len = newline != NULL ? (size_t)(newline - lineStart) : available;
+            lineStart[len] = '\0';
+            reader->start += newline != NULL ? len + 1 : len;
+            reader->lineNumber++;
+            if (reader->skipping) {
+                reader->skipping = 0;
+                reader->lineTooLong = 1;
+                lineStart[0] = '\0';
+                *length = 0;
+                return lineStart;
+            }
+            if (len > 0 && lineStart[len - 1] == '\r') {
+                lineStart[--len] = '\0';
+            }
+            *length = len;
+            return lineStart;
+        }
+        if (reader->eof) {
+            return NULL;
+        }
+
+        // 缓冲区中没有完整的行: 把剩余数据移到开头, 继续读取
+        if (available == LINE_READER_BUFFER) {
+            reader->overlongLines++;
+            reader->skipping = 1;
+            available = 0;
+        }
+        memmove(reader->buffer, lineStart, available);
+        reader->start = 0;
+        reader->end = available;
+
+        size_t request = LINE_READER_BUFFER - reader->end;
+        if ((long long)request > reader->remaining) {
+            request = (size_t)reader->remaining;
+        }
+        size_t n = request > 0 ? fread(reader->buffer + reader->end, 1, request, reader->file) : 0;
+        reader->end += n;
+        reader->bytesRead += (long long)n;
+        reader->remaining -= (long long)n;
+        if (n == 0) {
+            reader->readError = request > 0 && ferror(reader->file);
+            reader->eof = 1;
+        }
+    }
+}
+
+// CSV字段解析 (RFC 4180): 在行读取器的缓冲区中就地拆分字段, 去除引号并还原转义的双引号,
+// 数值字段直接转换写入记录. 各读取函数在出错后不再读取, 整行读完再统一检查csv.error
+enum CsvError {
+    CsvOK = 0,
+    CsvMissingField,            // 字段数不足
+    CsvBadNumber,               // 数值字段不是有效的整数
+    CsvFieldTooLong,            // 字符串字段超过长度限制
+    CsvExtraField,              // 有多余的字段
+    CsvLineTooLong              // 整行超过行读取器的缓冲区大小
+};
+
+struct CsvCursor {
+    char* next;                 // 下一个字段的起始位置, NULL表示已无字段
+    char* end;                  // 行结束位置 (行以'\0'结尾)
+    int fields;                 // 已读取的字段数
+    int error;                  // enum CsvError
+};
+
+void csvBegin(struct CsvCursor* csv, char* line, size_t length) {
+    csv->next = line;
+    csv->end = line + length;
+    csv->fields = 0;
+    csv->error = CsvOK;
+}
+
+// 取出下一个字段 (就地改写为以'\0'结尾的字段内容), 无更多字段时返回NULL
+char* csvField(struct CsvCursor* csv, size_t* length) {
+    char* field = csv->next;
+    if (field == NULL) {
+        return NULL;
+    }
+    csv->fields++;
+    if (*field == '"') {
+        // 带引号的字段: 先找到结束引号, 两个连续的双引号表示一个双引号
+        char* close = field + 1;
+        int escapes = 0;
+        while (close < csv->end) {
+            if (*close == '"') {
+                if (close[1] != '"') {
+                    break;
+                }
+                escapes++;
+                close++;
+            }
+            close++;
+        }
+        if (close < csv->end && (close + 1 == csv->end || close[1] == ',')) {
+            csv->next = close + 1 < csv->end ? close + 2 : NULL;
+            *close = '\0';
+            field++;
+            if (escapes > 0) {
+                // 还原转义的双引号, 内容前移覆盖多余的引号
+                char* write = field;
+                for (char* read = field; read < close; read++) {
+                    *write++ = *read;
+                    if (*read == '"') {
+                        read++;
+                    }
+                }
+                *write = '\0';
+                close = write;
+            }
+            *length = (size_t)(close - field);
+            return field;
+        }
+        // 引号不配对: 旧版本保存时未转义引号, 会产生""abc""这样的字段.
+        // 按未加引号的字段读到下一个逗号, 再去掉首尾成对的引号
+        char* comma = (char*)memchr(field, ',', (size_t)(csv->end - field));
+        char* fieldEnd = comma != NULL ? comma : csv->end;
+        csv->next = comma != NULL ? comma + 1 : NULL;
+        while (fieldEnd - field >= 2 && field[0] == '"' && fieldEnd[-1] == '"') {
+            field++;
+            fieldEnd--;
+        }
+        *fieldEnd = '\0';
+        *length = (size_t)(fieldEnd - field);
+        return field;
+    }
+    char* comma = (char*)memchr(field, ',', (size_t)(csv->end - field));
+    if (comma != NULL) {
+        *comma = '\0';
+        csv->next = comma + 1;
+        *length = (size_t)(comma - field);
+    } else {
+        csv->next = NULL;
+        *length = (size_t)(csv->end - field);
+    }
+    return field;
+}
+
+// 读取整数字段 (允许前后空白), 取值须在[min, max]范围内
+void csvLongLong(struct CsvCursor* csv, long long* out, long long min, long long max) {
+    if (csv->error != CsvOK) {
+        return;
+    }
+    size_t length;
+    const char* p = csvField(csv, &length);
+    if (p == NULL) {
+        csv->error = CsvMissingField;
+        return;
+    }
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+    int negative = 0;
+    if (*p == '-' || *p == '+') {
+        negative = *p == '-';
+        p++;
+    }
+    if (*p < '0' || *p > '9') {
+        csv->error = CsvBadNumber;
+        return;
+    }
+    unsigned long long value = 0;
+    for (; *p >= '0' && *p <= '9'; p++) {
+        unsigned int digit = (unsigned int)(*p - '0');
+        if (value > (9223372036854775807ULL - digit) / 10) {
+            csv->error = CsvBadNumber;
+            return;
+        }
+        value = value * 10 + digit;
+    }
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+    long long result = negative ? -(long long)value : (long long)value;
+    if (*p != '\0' || result < min || result > max) {
+        csv->error = CsvBadNumber;
+        return;
+    }
+    *out = result;
+}
+
+void csvInt(struct CsvCursor* csv, int* out) {
+    long long value = 0;
+    csvLongLong(csv, &value, INT_MIN, INT_MAX);
+    if (csv->error == CsvOK) {
+        *out = (int)value;
+    }
+}
+
+// 读取字符串字段到定长数组 (size含结尾的'\0'), 超长时报错
+void csvString(struct CsvCursor* csv, char* out, size_t size) {
+    if (csv->error != CsvOK) {
+        return;
+    }
+    size_t length;
+    const char* field = csvField(csv, &length);
+    if (field == NULL) {
+        csv->error = CsvMissingField;
+        return;
+    }
+    if (length >= size) {
+        csv->error = CsvFieldTooLong;
+        return;
+    }
+    memcpy(out, field, length + 1);
+}
+
+// 整行读取完毕: 没有多余字段且未出错时返回1
+int csvEnd(struct CsvCursor* csv) {
+    if (csv->error == CsvOK && csv->next != NULL) {
+        csv->error = CsvExtraField;
+    }
+    return csv->error == CsvOK;
+}
+
+// 报告被跳过的行: error为enum CsvError, fields为出错时已读取的字段数
+void csvReportError(int error, int fields, long long lineNumber) {
+    switch (error) {
+        case CsvMissingField:
+            printf("警告: 第%lld行格式不正确, 只读取到%d个字段，跳过此行\n", lineNumber, fields);
+            break;
+        case CsvBadNumber:
+            printf("警告: 第%lld行第%d个字段不是有效的数字，跳过此行\n", lineNumber, fields);
+            break;
+        case CsvFieldTooLong:
+            printf("警告: 第%lld行第%d个字段过长，跳过此行\n", lineNumber, fields);
+            break;
+        case CsvLineTooLong:
+            printf("警告: 第%lld行超过%d字节，已跳过此行\n", lineNumber, LINE_READER_BUFFER);
+            break;
+        default:
+            printf("警告: 第%lld行有多余内容，跳过此行\n", lineNumber);
+            break;
+    }
+}
+
+// 转义字符串字段中的双引号 (写入时两侧另加引号); 不含引号时直接返回原字符串,
+// 否则写入buffer (大小至少为原长度的两倍加1) 并返回buffer
+const char* csvEscape(const char* text, char* buffer) {
+    if (strchr(text, '"') == NULL) {
+        return text;
+    }
+    char* out = buffer;
+    for (; *text != '\0'; text++) {
+        if (*text == '"') {
+            *out++ = '"';
+        }
+        *out++ = *text;
+    }
+    *out = '\0';
+    return buffer;
+}
+
+// 当前时间 (秒), 用于统计加载吞吐量
+double nowSeconds() {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 互斥锁 (Windows临界区 / POSIX互斥量)
+struct Mutex {
+#ifdef _WIN32
+    CRITICAL_SECTION handle;
+#else
+    pthread_mutex_t handle;
+#endif
+};
+
+void mutexInit(struct Mutex* mutex) {
+#ifdef _WIN32
+    InitializeCriticalSection(&mutex->handle);
+#else
+    pthread_mutex_init(&mutex->handle, NULL);
+#endif
+}
+
+void mutexDestroy(struct Mutex* mutex) {
+#ifdef _WIN32
+    DeleteCriticalSection(&mutex->handle);
+#else
+    pthread_mutex_destroy(&mutex->handle);
+#endif
+}
+
+void mutexLock(struct Mutex* mutex) {
+#ifdef _WIN32
+    EnterCriticalSection(&mutex->handle);
+#else
+    pthread_mutex_lock(&mutex->handle);
+#endif
+}
+
+void mutexUnlock(struct Mutex* mutex) {
+#ifdef _WIN32
+    LeaveCriticalSection(&mutex->handle);
+#else
+    pthread_mutex_unlock(&mutex->handle);
+#endif
+}
+
+// 工作线程池: 工作线程与调用线程一起按顺序领取任务, 全部任务完成后返回
+#define WORKER_MAX_THREADS 64
+
+struct WorkQueue {
+    void (*run)(void* task);
+    char* tasks;
+    size_t taskSize;
+    int taskCount;
+    int next;                   // 下一个待领取的任务
+    struct Mutex lock;
+};
+
+// 可用的处理器数量
+int cpuCount() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int count = (int)info.dwNumberOfProcessors;
+#else
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return count > 0 ? count : 1;
+}
+
+// 领取下一个任务, 没有剩余任务时返回-1
+int workQueueTake(struct WorkQueue* queue) {
+    mutexLock(&queue->lock);
+    int task = queue->next < queue->taskCount ? queue->next++ : -1;
+    mutexUnlock(&queue->lock);
+    return task;
+}
+
+void workQueueDrain(struct WorkQueue* queue) {
+    int task;
+    while ((task = workQueueTake(queue)) >= 0) {
+        queue->run(queue->tasks + (size_t)task * queue->taskSize);
+    }
+}
+
+#ifdef _WIN32
+DWORD WINAPI workQueueThread(LPVOID queue) {
+    workQueueDrain((struct WorkQueue*)queue);
+    return 0;
+}
+#else
+void* workQueueThread(void* queue) {
+    workQueueDrain((struct WorkQueue*)queue);
+    return NULL;
+}
+#endif
+
+// 用至多threads个线程 (含调用线程) 执行taskCount个任务, 任务按数组顺序领取;
+// 线程创建失败时由已有的线程完成剩余任务
+void runParallel(void (*run)(void* task), void* tasks, size_t taskSize, int taskCount, int threads) {
+    struct WorkQueue queue;
+    queue.run = run;
+    queue.tasks = (char*)tasks;
+    queue.taskSize = taskSize;
+    queue.taskCount = taskCount;
+    queue.next = 0;
+    if (threads > taskCount) {
+        threads = taskCount;
+    }
+    if (threads > WORKER_MAX_THREADS) {
+        threads = WORKER_MAX_THREADS;
+    }
+    int started = 0;
+    mutexInit(&queue.lock);
+#ifdef _WIN32
+    HANDLE handles[WORKER_MAX_THREADS];
+    while (started < threads - 1) {
+        handles[started] = CreateThread(NULL, 0, workQueueThread, &queue, 0, NULL);
+        if (handles[started] == NULL) {
+            break;
+        }
+        started++;
+    }
+    workQueueDrain(&queue);
+    for (int i = 0; i < started; i++) {
+        WaitForSingleObject(handles[i], INFINITE);
+        CloseHandle(handles[i]);
+    }
+#else
+    pthread_t handles[WORKER_MAX_THREADS];
+    while (started < threads - 1 && pthread_create(&handles[started], NULL, workQueueThread, &queue) == 0) {
+        started++;
+    }
+    workQueueDrain(&queue);
+    for (int i = 0; i < started; i++) {
+        pthread_join(handles[i], NULL);
+    }
+#endif
+    mutexDestroy(&queue.lock);
+}
+
+// 启动时并行加载CSV文件, 分两个阶段:
+// 解析阶段各文件在线程池中同时解析, 较大的床位文件按行边界分成多块并行解析; 每个任务只写自己的内存池和行数组.
+// 合并阶段在主线程按依赖顺序 (床位、病人、医生、医生-病人、医生-病房) 逐块逐行查重并建立索引,
+// 解析出的记录所在的内存块直接并入全局内存池, 不再复制
+#define LOAD_CHUNK_BYTES (4 << 20)  // 床位文件每块的最小字节数, 较小的文件不分块
+
+enum LoadStatus {
+    LoadOK = 0,
+    LoadNoFile,                 // 无法打开文件
+    LoadEmpty,                  // 文件为空 (没有文件头)
+    LoadOutOfMemory,            // 内存不足, 在stopLine行停止解析
+    LoadReadError               // 读取出错, 在stopLine行后停止解析
+};
+
+// 解析出的一行记录及其在块内的行号
+struct LoadRow {
+    void* record;
+    long long lineNumber;
+};
+
+// 解析阶段跳过的行, 合并阶段按行号顺序报告
+struct LoadError {
+    long long lineNumber;       // 块内的行号
+    int error;                  // enum CsvError
+    int fields;
+};
+
+struct LoadTask {
+    int table;                  // enum DataTable
+    long long offset;           // 本块在文件中的起始位置 (行首)
+    long long length;           // 本块的字节数, -1表示读到文件末尾
+    struct SlabPool pool;       // 解析出的记录所在的内存池
+    struct LoadRow* rows;
+    int rowCount;
+    int rowCapacity;
+    struct LoadError* errors;
+    int errorCount;
+    int errorCapacity;
+    long long lines;            // 本块的行数, 用于换算后续块的行号
+    long long overlongLines;
+    int status;                 // enum LoadStatus
+    long long stopLine;
+    double seconds;             // 解析耗时
+};
+
+// 病人CSV行: 合并阶段再登记到病人表并恢复候床状态
+struct PatientRow {
+    struct Patient patient;
+    struct BedRequest request;
+    int acuity;
+    long long waitSince;
+    long long waitSeq;
+};
+
+// 逐字段就地解析CSV行, 数值和字符串直接写入记录
+void parseBedFields(struct CsvCursor* csv, void* record) {
+    struct Bed* bed = (struct Bed*)record;
+    csvInt(csv, &bed->ID);
+    csvInt(csv, &bed->isOccupied);
+    csvInt(csv, &bed->hasOxygen);
+    csvInt(csv, (int*)&bed->bedType);
+    csvInt(csv, &bed->ward);
+    csvInt(csv, &bed->department);
+    csvInt(csv, &bed->patient.patientID);
+    csvString(csv, bed->patient.name, sizeof(bed->patient.name));
+    csvInt(csv, &bed->patient.gender);
+    csvString(csv, bed->patient.phone, sizeof(bed->patient.phone));
+    csvString(csv, bed->patient.diagnosis, sizeof(bed->patient.diagnosis));
+    csvInt(csv, &bed->patient.age);
+}
+
+void parsePatientFields(struct CsvCursor* csv, void* record) {
+    struct PatientRow* row = (struct PatientRow*)record;
+    row->acuity = 0;
+    row->waitSince = 0;
+    row->waitSeq = 0;
+    csvInt(csv, &row->patient.patientID);
+    csvString(csv, row->patient.name, sizeof(row->patient.name));
+    csvInt(csv, &row->patient.gender);
+    csvString(csv, row->patient.phone, sizeof(row->patient.phone));
+    csvString(csv, row->patient.diagnosis, sizeof(row->patient.diagnosis));
+    csvInt(csv, &row->patient.age);
+    csvInt(csv, &row->acuity);
+    csvInt(csv, &row->request.bedType);
+    csvInt(csv, &row->request.department);
+    csvInt(csv, &row->request.needOxygen);
+    csvInt(csv, &row->request.preferredWard);
+    csvLongLong(csv, &row->waitSince, 0, LLONG_MAX);
+    csvLongLong(csv, &row->waitSeq, 0, LLONG_MAX);
+}
+
+void parseDoctorFields(struct CsvCursor* csv, void* record) {
+    struct Doctor* doctor = (struct Doctor*)record;
+    csvInt(csv, &doctor->doctorID);
+    csvString(csv, doctor->name, sizeof(doctor->name));
+    csvInt(csv, &doctor->gender);
+    csvString(csv, doctor->phone, sizeof(doctor->phone));
+    csvInt(csv, &doctor->department);
+    csvString(csv, doctor->specialization, sizeof(doctor->specialization));
+    csvInt(csv, &doctor->qualification);
+    csvString(csv, doctor->officeLocation, sizeof(doctor->officeLocation));
+}
+
+void parseDoctorPatientFields(struct CsvCursor* csv, void* record) {
+    struct DoctorPatientRelation* relation = (struct DoctorPatientRelation*)record;
+    csvInt(csv, &relation->doctorID);
+    csvInt(csv, &relation->patientID);
+    csvString(csv, relation->notes, sizeof(relation->notes));
+    csvString(csv, relation->startDate, sizeof(relation->startDate));
+}
+
+void parseDoctorWardFields(struct CsvCursor* csv, void* record) {
+    struct DoctorWardRelation* relation = (struct DoctorWardRelation*)record;
+    csvInt(csv, &relation->doctorID);
+    csvInt(csv, &relation->wardNumber);
+    csvInt(csv, &relation->isHeadDoctor);
+    csvString(csv, relation->scheduleInfo, sizeof(relation->scheduleInfo));
+}
+
+void (*const loadParsers[TABLE_COUNT])(struct CsvCursor* csv, void* record) = {
+    parseBedFields, parsePatientFields, parseDoctorFields, parseDoctorPatientFields, parseDoctorWardFields
+};
+
+const size_t loadRecordSizes[TABLE_COUNT] = {
+    sizeof(struct Bed), sizeof(struct PatientRow), sizeof(struct Doctor),
+    sizeof(struct DoctorPatientRelation), sizeof(struct DoctorWardRelation)
+};
+
+void loadTaskInit(struct LoadTask* task, int table, long long offset, long long length) {
+    memset(task, 0, sizeof(*task));
+    task->table = table;
+    task->offset = offset;
+    task->length = length;
+    task->pool.objectSize = loadRecordSizes[table] > sizeof(void*) ? loadRecordSizes[table] : sizeof(void*);
+    task->pool.nextSlabObjects = SLAB_MIN_OBJECTS;
+}
+
+void loadTaskFree(struct LoadTask* task) {
+    slabRelease(&task->pool);
+    free(task->rows);
+    free(task->errors);
+    task->rows = NULL;
+    task->errors = NULL;
+}
+
+// 按倍数扩容任务中的数组, 失败返回0
+int loadTaskGrow(void** items, int* capacity, size_t itemSize) {
+    int newCapacity = *capacity ? *capacity * 2 : 1024;
+    void* grown = realloc(*items, (size_t)newCapacity * itemSize);
+    if (grown == NULL) {
+        return 0;
+    }
+    *items = grown;
+    *capacity = newCapacity;
+    return 1;
+}
+
+int loadTaskAddError(struct LoadTask* task, long long lineNumber, int error, int fields) {
+    if (task->errorCount == task->errorCapacity &&
+        !loadTaskGrow((void**)&task->errors, &task->errorCapacity, sizeof(struct LoadError))) {
+        return 0;
+    }
+    struct LoadError* entry = &task->errors[task->errorCount++];
+    entry->lineNumber = lineNumber;
+    entry->error = error;
+    entry->fields = fields;
+    return 1;
+}
+
+// 解析阶段 (在工作线程中执行): 只读写任务自身的数据, 不访问全局索引, 不输出信息
+void loadTaskRun(void* arg) {
+    struct LoadTask* task = (struct LoadTask*)arg;
+    double startTime = nowSeconds();
+    struct LineReader reader;
+    if (!lineReaderOpen(&reader, tableFiles[task->table], task->offset, task->length)) {
+        task->status = LoadNoFile;
+        return;
+    }
+    size_t length;
+    char* line;
+
+    // 第一块含CSV文件头
+    if (task->offset == 0 && lineReaderNext(&reader, &length) == NULL) {
+        task->status = LoadEmpty;
+        lineReaderClose(&reader);
+        return;
+    }
+    while ((line = lineReaderNext(&reader, &length)) != NULL) {
+        if (reader.lineTooLong) {
+            if (!loadTaskAddError(task, reader.lineNumber, CsvLineTooLong, 0)) {
+                task->status = LoadOutOfMemory;
+                break;
+            }
+            continue;
+        }
+        if (length == 0) {
+            continue; // 空行
+        }
+        void* record = slabAlloc(&task->pool);
+        if (record == NULL ||
+            (task->rowCount == task->rowCapacity &&
+             !loadTaskGrow((void**)&task->rows, &task->rowCapacity, sizeof(struct LoadRow)))) {
+            task->status = LoadOutOfMemory;
+            break;
+        }
+        struct CsvCursor csv;
+        csvBegin(&csv, line, length);
+        loadParsers[task->table](&csv, record);
+        if (!csvEnd(&csv)) {
+            slabFree(&task->pool, record);
+            if (!loadTaskAddError(task, reader.lineNumber, csv.error, csv.fields)) {
+                task->status = LoadOutOfMemory;
+                break;
+            }
+            continue;
+        }
+        task->rows[task->rowCount].record = record;
+        task->rows[task->rowCount].lineNumber = reader.lineNumber;
+        task->rowCount++;
+    }
+    if (task->status == LoadOutOfMemory) {
+        task->stopLine = reader.lineNumber;
+    } else if (reader.readError) {
+        task->status = LoadReadError;
+        task->stopLine = reader.lineNumber;
+    }
+    task->lines = reader.lineNumber;
+    task->overlongLines = reader.overlongLines;
+    lineReaderClose(&reader);
+    task->seconds = nowSeconds() - startTime;
+}
+
+// 把文件按字节数分成至多chunks块, 各块边界后移到下一个换行符之后, 返回实际的块数.
+// 字段中不含换行符, 因此块边界总是落在行首
+int loadSplitFile(int table, int chunks, struct LoadTask* tasks) {
+    FILE* file = fopen(tableFiles[table], "rb");
+    long long size = file != NULL ? fileSizeOf(file) : 0;
+    if (chunks > size / LOAD_CHUNK_BYTES) {
+        chunks = (int)(size / LOAD_CHUNK_BYTES);
+    }
+    int count = 0;
+    long long start = 0;
+    char buffer[4096];
+    for (int i = 1; i < chunks; i++) {
+        long long position = size / chunks * i;
+        if (position <= start || fileSeek(file, position - 1) != 0) {
+            continue;
+        }
+        // 从position-1开始找换行符, 恰好落在行首时边界不变
+        long long boundary = -1;
+        size_t n;
+        while (boundary < 0 && (n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            char* newline = (char*)memchr(buffer, '\n', n);
+            if (newline != NULL) {
+                boundary = position + (long long)(newline - buffer);
+            } else {
+                position += (long long)n;
+            }
+        }
+        if (boundary < 0 || boundary >= size) {
+            break;
+        }
+        loadTaskInit(&tasks[count++], table, start, boundary - start);
+        start = boundary;
+    }
+    loadTaskInit(&tasks[count++], table, start, -1);
+    if (file != NULL) {
+        fclose(file);
+    }
+    return count;
+}
+
+// 合并阶段按行号顺序遍历同一文件各块解析出的记录, 同时按顺序报告解析阶段跳过的行
+struct LoadCursor {
+    struct LoadTask* tasks;
+    int taskCount;
+    int task;                   // 当前块
+    int row;                    // 当前块中下一条记录
+    int error;                  // 当前块中下一条待报告的跳过行
+    long long lineBase;         // 当前块之前各块的总行数
+    long long lineNumber;       // 最近返回的记录在文件中的行号
+    int rows;                   // 各块解析出的记录总数
+    int skipped;                // 格式错误的行数
+    long long overlongLines;
+    int stopped;                // 某块因内存不足或读取出错中途停止
+    double parseSeconds;        // 各块中最长的解析耗时
+    double startTime;           // 合并开始时间
+};
+
+// 开始合并: pool不为NULL时把各块的内存块并入该全局内存池 (之后丢弃的记录归还到该内存池).
+// 文件不存在或为空时输出提示并返回0
+int loadCursorBegin(struct LoadCursor* cursor, struct LoadTask* tasks, int taskCount, struct SlabPool* pool) {
+    memset(cursor, 0, sizeof(*cursor));
+    cursor->tasks = tasks;
+    cursor->taskCount = taskCount;
+    cursor->startTime = nowSeconds();
+    if (tasks[0].status == LoadNoFile) {
+        printf("无法打开文件 %s，将创建新文件\n", tableFiles[tasks[0].table]);
+        return 0;
+    }
+    if (tasks[0].status == LoadEmpty) {
+        printf("文件为空或格式不正确\n");
+        return 0;
+    }
+    for (int i = 0; i < taskCount; i++) {
+        cursor->rows += tasks[i].rowCount;
+        cursor->skipped += tasks[i].errorCount;
+        cursor->overlongLines += tasks[i].overlongLines;
+        if (tasks[i].seconds > cursor->parseSeconds) {
+            cursor->parseSeconds = tasks[i].seconds;
+        }
+        if (pool != NULL) {
+            slabAdopt(pool, &tasks[i].pool);
+        }
+    }
+    cursor->skipped -= (int)cursor->overlongLines;
+    return 1;
+}
+
+// 报告当前块中行号小于lineNumber的跳过行
+void loadCursorReport(struct LoadCursor* cursor, long long lineNumber) {
+    struct LoadTask* task = &cursor->tasks[cursor->task];
+    while (cursor->error < task->errorCount && task->errors[cursor->error].lineNumber < lineNumber) {
+        struct LoadError* entry = &task->errors[cursor->error++];
+        csvReportError(entry->error, entry->fields, cursor->lineBase + entry->lineNumber);
+    }
+}
+
+// 取下一条记录, 全部取完或某块解析中途停止时返回NULL
+void* loadCursorNext(struct LoadCursor* cursor) {
+    while (cursor->task < cursor->taskCount) {
+        struct LoadTask* task = &cursor->tasks[cursor->task];
+        if (cursor->row < task->rowCount) {
+            struct LoadRow* row = &task->rows[cursor->row++];
+            loadCursorReport(cursor, row->lineNumber);
+            cursor->lineNumber = cursor->lineBase + row->lineNumber;
+            return row->record;
+        }
+        loadCursorReport(cursor, LLONG_MAX);
+        if (task->status == LoadOutOfMemory) {
+            printf("内存分配失败，已在第%lld行停止加载\n", cursor->lineBase + task->stopLine);
+            cursor->stopped = 1;
+            cursor->task = cursor->taskCount;
+            break;
+        }
+        if (task->status == LoadReadError) {
+            printf("警告: 读取文件出错，已在第%lld行后停止\n", cursor->lineBase + task->stopLine);
+            cursor->stopped = 1;
+            cursor->task = cursor->taskCount;
+            break;
+        }
+        cursor->lineBase += task->lines;
+        cursor->task++;
+        cursor->row = 0;
+        cursor->error = 0;
+    }
+    return NULL;
+}
+
+// 合并结束后判断文件中的记录是否全部加载: 没有跳过的行, 解析未中途停止, 合并时也没有丢弃记录
+int loadCursorComplete(const struct LoadCursor* cursor, int recordCount) {
+    return cursor->skipped == 0 && cursor->overlongLines == 0 && !cursor->stopped && recordCount == cursor->rows;
+}
+
+// 打印加载统计: 跳过的行数、解析与合并耗时和每秒行数
+void printLoadStats(const struct LoadCursor* cursor, int recordCount) {
+    double mergeSeconds = nowSeconds() - cursor->startTime;
+    double elapsed = cursor->parseSeconds + mergeSeconds;
+    if (cursor->skipped > 0 || cursor->overlongLines > 0) {
+        printf("  跳过格式错误 %d 行，超长 %lld 行\n", cursor->skipped, cursor->overlongLines);
+    }
+    printf("  解析 %.3f 秒 (%d 块)，合并 %.3f 秒，%.0f 行/秒\n", cursor->parseSeconds, cursor->taskCount,
+           mergeSeconds, elapsed > 0 ? recordCount / elapsed : (double)recordCount);
+}
+
+// 整数键哈希函数 (乘法散列)
+unsigned int hashInt(int key) {
+    unsigned int h = (unsigned int)key * 2654435761u;
+    return h ^ (h >> 16);
+}
+
+// 64位键哈希函数
+unsigned int hashGram(unsigned long long key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (unsigned int)key;
+}
+
+// 在索引中查找床位ID所在的桶, 未找到时返回应插入的空桶位置
+int bedIndexProbe(int id) {
+    int mask = bedIndex.capacity - 1;
+    int i = (int)(hashInt(id) & (unsigned int)mask);
+    while (bedIndex.slots[i] != NULL && bedIndex.slots[i]->ID != id) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// 扩容并重新散列所有床位
+int bedIndexGrow(int newCapacity) {
+    struct Bed** oldSlots = bedIndex.slots;
+    int oldCapacity = bedIndex.capacity;
+
+    struct Bed** newSlots = (struct Bed**)calloc(newCapacity, sizeof(struct Bed*));
+    if (newSlots == NULL) {
+        return 0;
+    }
+
+    bedIndex.slots = newSlots;
+    bedIndex.capacity = newCapacity;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i] != NULL) {
+            bedIndex.slots[bedIndexProbe(oldSlots[i]->ID)] = oldSlots[i];
+        }
+    }
+    free(oldSlots);
+    return 1;
+}
+
+// 根据床位ID查找床位, O(1)
+struct Bed* findBedByID(int id) {
+    if (bedIndex.count == 0) {
+        return NULL;
+    }
+    return bedIndex.slots[bedIndexProbe(id)];
+}
+
+// 将床位加入索引, 成功返回1, 内存不足返回0
+int bedIndexInsert(struct Bed* bed) {
+    // 装载因子保持在0.5以下, 保证探测链足够短
+    if ((bedIndex.count + 1) * 2 > bedIndex.capacity) {
+        int newCapacity = bedIndex.capacity ? bedIndex.capacity * 2 : 64;
+        if (!bedIndexGrow(newCapacity)) {
+            return 0;
+        }
+    }
+    int i = bedIndexProbe(bed->ID);
+    if (bedIndex.slots[i] == NULL) {
+        bedIndex.count++;
+    }
+    bedIndex.slots[i] = bed;
+    return 1;
+}
+
+// 从索引中移除床位ID (向后移位删除, 不留墓碑)
+void bedIndexRemove(int id) {
+    if (bedIndex.count == 0) {
+        return;
+    }
+    int mask = bedIndex.capacity - 1;
+    int i = bedIndexProbe(id);
+    if (bedIndex.slots[i] == NULL) {
+        return;
+    }
+    bedIndex.slots[i] = NULL;
+    bedIndex.count--;
+
+    // 将后续探测链上的元素前移, 填补空洞
+    int j = (i + 1) & mask;
+    while (bedIndex.slots[j] != NULL) {
+        int home = (int)(hashInt(bedIndex.slots[j]->ID) & (unsigned int)mask);
+        // 只有当home不在(i, j]区间内时, 该元素才能移动到i
+        if ((j > i && (home <= i || home > j)) || (j < i && (home <= i && home > j))) {
+            bedIndex.slots[i] = bedIndex.slots[j];
+            bedIndex.slots[j] = NULL;
+            i = j;
+        }
+        j = (j + 1) & mask;
+    }
+}
+
+// 分配一个跳表节点
+struct BedSkipNode* bedSkipNodeCreate(struct Bed* bed, int level) {
+    struct BedSkipNode* node = (struct BedSkipNode*)malloc(sizeof(struct BedSkipNode) +
+                                                           level * sizeof(struct BedSkipNode*));
+    if (node == NULL) {
+        return NULL;
+    }
+    node->bed = bed;
+    node->level = level;
+    for (int i = 0; i < level; i++) {
+        node->forward[i] = NULL;
+    }
+    return node;
+}
+
+// 生成随机层数, 每层晋升概率为1/4
+int bedOrderRandomLevel() {
+    int level = 1;
+    while (level < SKIPLIST_MAX_LEVEL) {
+        // xorshift32
+        bedOrder.seed ^= bedOrder.seed << 13;
+        bedOrder.seed ^= bedOrder.seed >> 17;
+        bedOrder.seed ^= bedOrder.seed << 5;
+        if ((bedOrder.seed & 3) != 0) {
+            break;
+        }
+        level++;
+    }
+    return level;
+}
+
+// 查找每层中ID小于id的最后一个节点, 结果写入update
+void bedOrderFindPredecessors(int id, struct BedSkipNode** update) {
+    struct BedSkipNode* node = bedOrder.header;
+    for (int i = bedOrder.level - 1; i >= 0; i--) {
+        while (node->forward[i] != NULL && node->forward[i]->bed->ID < id) {
+            node = node->forward[i];
+        }
+        update[i] = node;
+    }
+}
+
+// 将床位加入有序索引, O(log n), 成功返回1
+int bedOrderInsert(struct Bed* bed) {
+    if (bedOrder.header == NULL) {
+        bedOrder.header = bedSkipNodeCreate(NULL, SKIPLIST_MAX_LEVEL);
+        if (bedOrder.header == NULL) {
+            return 0;
+        }
+        bedOrder.level = 1;
+    }
+
+    struct BedSkipNode* update[SKIPLIST_MAX_LEVEL];
+    bedOrderFindPredecessors(bed->ID, update);
+
+    int level = bedOrderRandomLevel();
+    struct BedSkipNode* node = bedSkipNodeCreate(bed, level);
+    if (node == NULL) {
+        return 0;
+    }
+    for (int i = bedOrder.level; i < level; i++) {
+        update[i] = bedOrder.header;
+    }
+    if (level > bedOrder.level) {
+        bedOrder.level = level;
+    }
+    for (int i = 0; i < level; i++) {
+        node->forward[i] = update[i]->forward[i];
+        update[i]->forward[i] = node;
+    }
+    return 1;
+}
+
+// 将床位ID从有序索引中移除, O(log n)
+void bedOrderRemove(int id) {
+    if (bedOrder.header == NULL) {
+        return;
+    }
+    struct BedSkipNode* update[SKIPLIST_MAX_LEVEL];
+    bedOrderFindPredecessors(id, update);
+
+    struct BedSkipNode* node = update[0]->forward[0];
+    if (node == NULL || node->bed->ID != id) {
+        return;
+    }
+    for (int i = 0; i < node->level; i++) {
+        update[i]->forward[i] = node->forward[i];
+    }
+    while (bedOrder.level > 1 && bedOrder.header->forward[bedOrder.level - 1] == NULL) {
+        bedOrder.level--;
+    }
+    free(node);
+}
+
+// 返回第一个ID不小于id的节点, 没有时返回NULL
+struct BedSkipNode* bedOrderSeek(int id) {
+    if (bedOrder.header == NULL) {
+        return NULL;
+    }
+    struct BedSkipNode* update[SKIPLIST_MAX_LEVEL];
+    bedOrderFindPredecessors(id, update);
+    return update[0]->forward[0];
+}
+
+// 释放有序索引
+void bedOrderFree() {
+    struct BedSkipNode* node = bedOrder.header;
+    while (node != NULL) {
+        struct BedSkipNode* next = node->forward[0];
+        free(node);
+        node = next;
+    }
+    bedOrder.header = NULL;
+    bedOrder.level = 1;
+}
+
+// 将床位插入链表头部
+void linkBedAtHead(struct Bed* bed) {
+    bed->prev = NULL;
+    bed->next = head;
+    if (head != NULL) {
+        head->prev = bed;
+    }
+    head = bed;
+}
+
+// 将床位从链表中摘除, O(1)
+void unlinkBed(struct Bed* bed) {
+    if (bed->prev != NULL) {
+        bed->prev->next = bed->next;
+    } else {
+        head = bed->next;
+    }
+    if (bed->next != NULL) {
+        bed->next->prev = bed->prev;
+    }
+    bed->next = NULL;
+    bed->prev = NULL;
+}
+
+// 将取值压缩为单字节列编码
+unsigned char bedColumnCode(int value) {
+    return (value >= 0 && value < BED_CODE_OTHER) ? (unsigned char)value : BED_CODE_OTHER;
+}
+
+// 确保列存储至少能容纳capacity个槽位
+int bedColumnsReserve(int capacity) {
+    if (capacity <= bedColumns.capacity) {
+        return 1;
+    }
+    int newCapacity = bedColumns.capacity ? bedColumns.capacity : 64;
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+
+    int* ids = (int*)realloc(bedColumns.ID, newCapacity * sizeof(int));
+    if (ids != NULL) bedColumns.ID = ids;
+    unsigned char* occupied = (unsigned char*)realloc(bedColumns.isOccupied, newCapacity);
+    if (occupied != NULL) bedColumns.isOccupied = occupied;
+    unsigned char* oxygen = (unsigned char*)realloc(bedColumns.hasOxygen, newCapacity);
+    if (oxygen != NULL) bedColumns.hasOxygen = oxygen;
+    unsigned char* types = (unsigned char*)realloc(bedColumns.bedType, newCapacity);
+    if (types != NULL) bedColumns.bedType = types;
+    int* wards = (int*)realloc(bedColumns.ward, newCapacity * sizeof(int));
+    if (wards != NULL) bedColumns.ward = wards;
+    unsigned char* departments = (unsigned char*)realloc(bedColumns.department, newCapacity);
+    if (departments != NULL) bedColumns.department = departments;
+    struct Bed** records = (struct Bed**)realloc(bedColumns.record, newCapacity * sizeof(struct Bed*));
+    if (records != NULL) bedColumns.record = records;
+
+    // 任一列扩容失败时保持原容量, 已扩容的列仍然有效
+    if (ids == NULL || occupied == NULL || oxygen == NULL || types == NULL ||
+        wards == NULL || departments == NULL || records == NULL) {
+        return 0;
+    }
+    bedColumns.capacity = newCapacity;
+    return 1;
+}
+
+// 将床位的热数据字段写入其所在槽位
+void bedColumnsSync(struct Bed* bed) {
+    int i = bed->slot;
+    bedColumns.ID[i] = bed->ID;
+    bedColumns.isOccupied[i] = bed->isOccupied ? 1 : 0;
+    bedColumns.hasOxygen[i] = bed->hasOxygen ? 1 : 0;
+    bedColumns.bedType[i] = bedColumnCode(bed->bedType);
+    bedColumns.ward[i] = bed->ward;
+    bedColumns.department[i] = bedColumnCode(bed->department);
+}
+
+// 移除床位所在槽位, 用最后一个槽位填补空洞
+void bedColumnsRemove(struct Bed* bed) {
+    int i = bed->slot;
+    int last = bedColumns.count - 1;
+    if (i != last) {
+        struct Bed* moved = bedColumns.record[last];
+        bedColumns.record[i] = moved;
+        moved->slot = i;
+        bedColumnsSync(moved);
+    }
+    bedColumns.count--;
+    bed->slot = -1;
+}
+
+// 统计64位字中置位的数量
+int popcount64(unsigned long long x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// 返回最低置位的位置 (x不为0)
+int lowestBit64(unsigned long long x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    return popcount64((x & (0ULL - x)) - 1);
+#endif
+}
+
+// 槽位总数对应的64位字数量
+int bitsetWords(int bits) {
+    return (bits + 63) / 64;
+}
+
+void bitsetSet(unsigned long long* bits, int i) {
+    bits[i >> 6] |= 1ULL << (i & 63);
+}
+
+void bitsetClear(unsigned long long* bits, int i) {
+    bits[i >> 6] &= ~(1ULL << (i & 63));
+}
+
+// 将位图扩容到newWords个字, 新增部分清零
+unsigned long long* bitsetGrow(unsigned long long* bits, int oldWords, int newWords) {
+    unsigned long long* grown = (unsigned long long*)realloc(bits, newWords * sizeof(unsigned long long));
+    if (grown != NULL) {
+        memset(grown + oldWords, 0, (newWords - oldWords) * sizeof(unsigned long long));
+    }
+    return grown;
+}
+
+// 标记槽位所在的页在下次保存时写回床位检查点文件; 内存不足时改为下次整体重写.
+// 文件未同步时同样记录: 后台检查点整体重写期间修改的页须在下一次检查点写回
+void bedPageTouch(int slot) {
+    int page = slot / BED_PAGE_RECORDS;
+    if (page >= bedFile.dirtyWords * 64) {
+        int words = bitsetWords(page + 1) * 2;
+        unsigned long long* bits = bitsetGrow(bedFile.dirtyPages, bedFile.dirtyWords, words);
+        if (bits == NULL) {
+            bedFile.pagesLost = 1;
+            return;
+        }
+        bedFile.dirtyPages = bits;
+        bedFile.dirtyWords = words;
+    }
+    bitsetSet(bedFile.dirtyPages, page);
+}
+
+// 当前已用槽位占用的64位字数量
+int bedBitmapWords() {
+    return bitsetWords(bedColumns.count);
+}
+
+// 确保所有位图都能容纳bedColumns.capacity个槽位
+int bedBitmapsReserve() {
+    int newWords = bitsetWords(bedColumns.capacity);
+    int oldWords = bedBitmaps.wordCapacity;
+    if (newWords <= oldWords) {
+        return 1;
+    }
+
+    unsigned long long* grown = bitsetGrow(bedBitmaps.occupied, oldWords, newWords);
+    if (grown == NULL) return 0;
+    bedBitmaps.occupied = grown;
+    for (int t = 0; t <= BED_TYPE_COUNT; t++) {
+        grown = bitsetGrow(bedBitmaps.byType[t], oldWords, newWords);
+        if (grown == NULL) return 0;
+        bedBitmaps.byType[t] = grown;
+    }
+    for (int d = 0; d <= DEPARTMENT_COUNT; d++) {
+        grown = bitsetGrow(bedBitmaps.byDepartment[d], oldWords, newWords);
+        if (grown == NULL) return 0;
+        bedBitmaps.byDepartment[d] = grown;
+    }
+    for (int w = 0; w < bedBitmaps.wardCount; w++) {
+        grown = bitsetGrow(bedBitmaps.wards[w].members, oldWords, newWords);
+        if (grown == NULL) return 0;
+        bedBitmaps.wards[w].members = grown;
+    }
+    // 只有全部扩容成功才更新容量, 失败时已扩容的位图仍可按旧容量使用
+    bedBitmaps.wordCapacity = newWords;
+    return 1;
+}
+
+// 查找病房的位图, 不存在时返回NULL
+struct WardIndex* findWardIndex(int ward) {
+    if (bedBitmaps.wardSlotCapacity == 0) {
+        return NULL;
+    }
+    int mask = bedBitmaps.wardSlotCapacity - 1;
+    int i = (int)(hashInt(ward) & (unsigned int)mask);
+    while (bedBitmaps.wardSlots[i] != 0) {
+        struct WardIndex* entry = &bedBitmaps.wards[bedBitmaps.wardSlots[i] - 1];
+        if (entry->ward == ward) {
+            return entry;
+        }
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+// 重建病房号散列表
+int wardSlotsRehash(int newCapacity) {
+    int* slots = (int*)calloc(newCapacity, sizeof(int));
+    if (slots == NULL) {
+        return 0;
+    }
+    int mask = newCapacity - 1;
+    for (int w = 0; w < bedBitmaps.wardCount; w++) {
+        int i = (int)(hashInt(bedBitmaps.wards[w].ward) & (unsigned int)mask);
+        while (slots[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = w + 1;
+    }
+    free(bedBitmaps.wardSlots);
+    bedBitmaps.wardSlots = slots;
+    bedBitmaps.wardSlotCapacity = newCapacity;
+    return 1;
+}
+
+// 查找病房的位图, 不存在时创建
+struct WardIndex* getWardIndex(int ward) {
+    struct WardIndex* entry = findWardIndex(ward);
+    if (entry != NULL) {
+        return entry;
+    }
+
+    if (bedBitmaps.wardCount == bedBitmaps.wardCapacity) {
+        int newCapacity = bedBitmaps.wardCapacity ? bedBitmaps.wardCapacity * 2 : 16;
+        struct WardIndex* wards = (struct WardIndex*)realloc(bedBitmaps.wards, newCapacity * sizeof(struct WardIndex));
+        if (wards == NULL) {
+            return NULL;
+        }
+        bedBitmaps.wards = wards;
+        bedBitmaps.wardCapacity = newCapacity;
+    }
+    if ((bedBitmaps.wardCount + 1) * 2 > bedBitmaps.wardSlotCapacity) {
+        if (!wardSlotsRehash(bedBitmaps.wardSlotCapacity ? bedBitmaps.wardSlotCapacity * 2 : 32)) {
+            return NULL;
+        }
+    }
+
+    unsigned long long* members = (unsigned long long*)calloc(bedBitmaps.wordCapacity ? bedBitmaps.wordCapacity : 1,
+                                                              sizeof(unsigned long long));
+    if (members == NULL) {
+        return NULL;
+    }
+
+    entry = &bedBitmaps.wards[bedBitmaps.wardCount++];
+    entry->ward = ward;
+    entry->members = members;
+    entry->counter.total = 0;
+    entry->counter.occupied = 0;
+    memset(entry->freeBeds, 0, sizeof(entry->freeBeds));
+
+    int mask = bedBitmaps.wardSlotCapacity - 1;
+    int i = (int)(hashInt(ward) & (unsigned int)mask);
+    while (bedBitmaps.wardSlots[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    bedBitmaps.wardSlots[i] = bedBitmaps.wardCount;
+    return entry;
+}
+
+// 床位类型对应的位图下标
+int bedTypeBitmapIndex(int bedType) {
+    return (bedType >= 0 && bedType < BED_TYPE_COUNT) ? bedType : BED_TYPE_COUNT;
+}
+
+// 科室编号对应的位图下标
+int departmentBitmapIndex(int department) {
+    return (department >= 1 && department <= DEPARTMENT_COUNT) ? department : 0;
+}
+
+// 空闲床位分类下标
+int freeClassIndex(int typeIndex, int departmentIndex, int hasOxygen) {
+    return (typeIndex * (DEPARTMENT_COUNT + 1) + departmentIndex) * 2 + (hasOxygen ? 1 : 0);
+}
+
+// 交换堆中两个位置并更新床位记录的位置
+void bedHeapSwap(struct BedHeap* heap, int a, int b, int which) {
+    struct Bed* tmp = heap->items[a];
+    heap->items[a] = heap->items[b];
+    heap->items[b] = tmp;
+    heap->items[a]->heapPos[which] = a;
+    heap->items[b]->heapPos[which] = b;
+}
+
+void bedHeapSiftUp(struct BedHeap* heap, int i, int which) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap->items[parent]->ID <= heap->items[i]->ID) {
+            break;
+        }
+        bedHeapSwap(heap, i, parent, which);
+        i = parent;
+    }
+}
+
+void bedHeapSiftDown(struct BedHeap* heap, int i, int which) {
+    while (1) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < heap->count && heap->items[left]->ID < heap->items[smallest]->ID) {
+            smallest = left;
+        }
+        if (right < heap->count && heap->items[right]->ID < heap->items[smallest]->ID) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            break;
+        }
+        bedHeapSwap(heap, i, smallest, which);
+        i = smallest;
+    }
+}
+
+// 将床位加入堆, O(log n)
+int bedHeapPush(struct BedHeap* heap, struct Bed* bed, int which) {
+    if (heap->count == heap->capacity) {
+        int newCapacity = heap->capacity ? heap->capacity * 2 : 8;
+        struct Bed** items = (struct Bed**)realloc(heap->items, newCapacity * sizeof(struct Bed*));
+        if (items == NULL) {
+            return 0;
+        }
+        heap->items = items;
+        heap->capacity = newCapacity;
+    }
+    int i = heap->count++;
+    heap->items[i] = bed;
+    bed->heapPos[which] = i;
+    bedHeapSiftUp(heap, i, which);
+    return 1;
+}
+
+// 将床位从堆中删除, O(log n)
+void bedHeapRemove(struct BedHeap* heap, struct Bed* bed, int which) {
+    int i = bed->heapPos[which];
+    if (i < 0 || i >= heap->count || heap->items[i] != bed) {
+        return; // 不在该堆中
+    }
+    int last = --heap->count;
+    if (i != last) {
+        heap->items[i] = heap->items[last];
+        heap->items[i]->heapPos[which] = i;
+        bedHeapSiftDown(heap, i, which);
+        bedHeapSiftUp(heap, i, which);
+    }
+    bed->heapPos[which] = -1;
+}
+
+// 堆顶床位, 堆为空时返回NULL
+struct Bed* bedHeapTop(const struct BedHeap* heap) {
+    return heap->count > 0 ? heap->items[0] : NULL;
+}
+
+// 将一个床位计入(delta=1)或移出(delta=-1)计数器
+void bedCounterApply(struct BedCounter* counter, int occupied, int delta) {
+    counter->total += delta;
+    if (occupied) {
+        counter->occupied += delta;
+    }
+}
+
+// 按槽位i当前的列数据置位, 并计入统计
+int bedBitmapsSetSlot(int i) {
+    struct Bed* bed = bedColumns.record[i];
+    struct WardIndex* ward = getWardIndex(bed->ward);
+    if (ward == NULL) {
+        return 0;
+    }
+    int type = bedTypeBitmapIndex(bed->bedType);
+    int department = departmentBitmapIndex(bed->department);
+    int occupied = bedColumns.isOccupied[i];
+
+    bitsetSet(ward->members, i);
+    bitsetSet(bedBitmaps.byType[type], i);
+    bitsetSet(bedBitmaps.byDepartment[department], i);
+    if (occupied) {
+        bitsetSet(bedBitmaps.occupied, i);
+    }
+
+    bedCounterApply(&bedStats.all, occupied, 1);
+    bedCounterApply(&bedStats.byType[type], occupied, 1);
+    bedCounterApply(&bedStats.byDepartment[department], occupied, 1);
+    bedCounterApply(&ward->counter, occupied, 1);
+
+    bed->heapPos[0] = -1;
+    bed->heapPos[1] = -1;
+    if (!occupied) {
+        int freeClass = freeClassIndex(type, department, bedColumns.hasOxygen[i]);
+        if (!bedHeapPush(&freeBedHeaps[freeClass], bed, 0) ||
+            !bedHeapPush(&ward->freeBeds[freeClass], bed, 1)) {
+            printf("警告: 内存不足，床位 %d 未加入自动分配队列\n", bed->ID);
+        }
+    }
+    return 1;
+}
+
+// 按槽位i当前的列数据清位, 并移出统计 (须在列数据被覆盖前调用)
+void bedBitmapsClearSlot(int i) {
+    // 列中的BED_CODE_OTHER与越界取值一样归入"其他"位图
+    int type = bedTypeBitmapIndex(bedColumns.bedType[i]);
+    int department = departmentBitmapIndex(bedColumns.department[i]);
+    int occupied = bedColumns.isOccupied[i];
+
+    int freeClass = freeClassIndex(type, department, bedColumns.hasOxygen[i]);
+    struct Bed* bed = bedColumns.record[i];
+
+    struct WardIndex* ward = findWardIndex(bedColumns.ward[i]);
+    if (ward != NULL) {
+        bitsetClear(ward->members, i);
+        bedCounterApply(&ward->counter, occupied, -1);
+        bedHeapRemove(&ward->freeBeds[freeClass], bed, 1);
+    }
+    bedHeapRemove(&freeBedHeaps[freeClass], bed, 0);
+    bitsetClear(bedBitmaps.byType[type], i);
+    bitsetClear(bedBitmaps.byDepartment[department], i);
+    bitsetClear(bedBitmaps.occupied, i);
+
+    bedCounterApply(&bedStats.all, occupied, -1);
+    bedCounterApply(&bedStats.byType[type], occupied, -1);
+    bedCounterApply(&bedStats.byDepartment[department], occupied, -1);
+}
+
+// 当前空闲床位数量
+int countFreeBeds() {
+    return bedStats.all.total - bedStats.all.occupied;
+}
+
+// 按约束条件选择最合适的空闲床位, 没有满足条件的床位时返回NULL
+// 优先顺序: 优先病房内 > 其他病房; 不需要供氧时先用无供氧床位, 把供氧床位留给需要的病人;
+// 同等条件下取床位ID最小者. 只查看堆顶, O(1); 分配后的出堆为O(log n)
+struct Bed* allocateBed(const struct BedRequest* request) {
+    int typeIndex = bedTypeBitmapIndex(request->bedType);
+    int departmentIndex = departmentBitmapIndex(request->department);
+    int classes[2];
+    int classCount = 0;
+
+    if (!request->needOxygen) {
+        classes[classCount++] = freeClassIndex(typeIndex, departmentIndex, 0);
+    }
+    classes[classCount++] = freeClassIndex(typeIndex, departmentIndex, 1);
+
+    if (request->preferredWard != 0) {
+        struct WardIndex* ward = findWardIndex(request->preferredWard);
+        for (int c = 0; ward != NULL && c < classCount; c++) {
+            struct Bed* bed = bedHeapTop(&ward->freeBeds[classes[c]]);
+            if (bed != NULL) {
+                return bed;
+            }
+        }
+    }
+    for (int c = 0; c < classCount; c++) {
+        struct Bed* bed = bedHeapTop(&freeBedHeaps[classes[c]]);
+        if (bed != NULL) {
+            return bed;
+        }
+    }
+    return NULL;
+}
+
+// 释放位图索引
+void bedBitmapsFree() {
+    free(bedBitmaps.occupied);
+    for (int t = 0; t <= BED_TYPE_COUNT; t++) {
+        free(bedBitmaps.byType[t]);
+    }
+    for (int d = 0; d <= DEPARTMENT_COUNT; d++) {
+        free(bedBitmaps.byDepartment[d]);
+    }
+    for (int w = 0; w < bedBitmaps.wardCount; w++) {
+        free(bedBitmaps.wards[w].members);
+        for (int c = 0; c < FREE_CLASS_COUNT; c++) {
+            free(bedBitmaps.wards[w].freeBeds[c].items);
+        }
+    }
+    for (int c = 0; c < FREE_CLASS_COUNT; c++) {
+        free(freeBedHeaps[c].items);
+    }
+    memset(freeBedHeaps, 0, sizeof(freeBedHeaps));
+    free(bedBitmaps.wards);
+    free(bedBitmaps.wardSlots);
+    memset(&bedBitmaps, 0, sizeof(bedBitmaps));
+    memset(&bedStats, 0, sizeof(bedStats));
+}
+
+// 检测CPU和操作系统是否支持AVX2
+int detectAvx2() {
+#if defined(HBM_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return 0;
+    }
+    __cpuid(info, 1);
+    // 需要OSXSAVE, 且操作系统保存了XMM/YMM寄存器状态
+    if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6) {
+        return 0;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(HBM_X86)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return 0;
+#endif
+}
+
+// 单字节列等值比较 (标量实现), 结果按槽位写入位图
+void scanEqU8Scalar(const unsigned char* column, int n, unsigned char value, unsigned long long* out) {
+    for (int w = 0; w < bitsetWords(n); w++) {
+        unsigned long long bits = 0;
+        int end = (w + 1) * 64 < n ? (w + 1) * 64 : n;
+        for (int i = w * 64; i < end; i++) {
+            bits |= (unsigned long long)(column[i] == value) << (i & 63);
+        }
+        out[w] = bits;
+    }
+}
+
+// 整数列等值比较 (标量实现)
+void scanEqI32Scalar(const int* column, int n, int value, unsigned long long* out) {
+    for (int w = 0; w < bitsetWords(n); w++) {
+        unsigned long long bits = 0;
+        int end = (w + 1) * 64 < n ? (w + 1) * 64 : n;
+        for (int i = w * 64; i < end; i++) {
+            bits |= (unsigned long long)(column[i] == value) << (i & 63);
+        }
+        out[w] = bits;
+    }
+}
+
+#ifdef HBM_X86
+// 单字节列等值比较 (AVX2): 每次比较32个槽位, movemask直接得到32位结果
+TARGET_AVX2 void scanEqU8Avx2(const unsigned char* column, int n, unsigned char value, unsigned long long* out) {
+    __m256i key = _mm256_set1_epi8((char)value);
+    int full = n / 64;
+    for (int w = 0; w < full; w++) {
+        __m256i lo = _mm256_loadu_si256((const __m256i*)(column + w * 64));
+        __m256i hi = _mm256_loadu_si256((const __m256i*)(column + w * 64 + 32));
+        unsigned int maskLo = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, key));
+        unsigned int maskHi = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, key));
+        out[w] = ((unsigned long long)maskHi << 32) | maskLo;
+    }
+    if (n % 64) {
+        scanEqU8Scalar(column + full * 64, n - full * 64, value, out + full);
+    }
+}
+
+// 整数列等值比较 (AVX2): 每次比较8个槽位
+TARGET_AVX2 void scanEqI32Avx2(const int* column, int n, int value, unsigned long long* out) {
+    __m256i key = _mm256_set1_epi32(value);
+    int full = n / 64;
+    for (int w = 0; w < full; w++) {
+        unsigned long long bits = 0;
+        for (int k = 0; k < 8; k++) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(column + w * 64 + k * 8));
+            unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, key)));
+            bits |= (unsigned long long)mask << (k * 8);
+        }
+        out[w] = bits;
+    }
+    if (n % 64) {
+        scanEqI32Scalar(column + full * 64, n - full * 64, value, out + full);
+    }
+}
+#endif
+
+// 单字节列等值比较, 按CPU能力选择内核
+void scanEqU8(const unsigned char* column, int n, unsigned char value, unsigned long long* out) {
+#ifdef HBM_X86
+    if (cpuHasAvx2) {
+        scanEqU8Avx2(column, n, value, out);
+        return;
+    }
+#endif
+    scanEqU8Scalar(column, n, value, out);
+}
+
+// 整数列等值比较, 按CPU能力选择内核
+void scanEqI32(const int* column, int n, int value, unsigned long long* out) {
+#ifdef HBM_X86
+    if (cpuHasAvx2) {
+        scanEqI32Avx2(column, n, value, out);
+        return;
+    }
+#endif
+    scanEqI32Scalar(column, n, value, out);
+}
+
+// 在列存储上求组合条件的命中位图, out和scratch均需bitsetWords(bedColumns.count)个字
+// 越界的类型/科室取值在列中编码为BED_CODE_OTHER, 命中后由调用方核对原始记录
+void bedFilterScan(const struct BedFilter* filter, unsigned long long* out, unsigned long long* scratch) {
+    int n = bedColumns.count;
+    int words = bitsetWords(n);
+
+    for (int w = 0; w < words; w++) {
+        out[w] = ~0ULL;
+    }
+    if (n % 64) {
+        out[words - 1] = (1ULL << (n % 64)) - 1;
+    }
+
+    if (filter->bedType != -1) {
+        scanEqU8(bedColumns.bedType, n, bedColumnCode(filter->bedType), scratch);
+        for (int w = 0; w < words; w++) out[w] &= scratch[w];
+    }
+    if (filter->department != -1) {
+        scanEqU8(bedColumns.department, n, bedColumnCode(filter->department), scratch);
+        for (int w = 0; w < words; w++) out[w] &= scratch[w];
+    }
+    if (filter->hasOxygen != -1) {
+        scanEqU8(bedColumns.hasOxygen, n, filter->hasOxygen ? 1 : 0, scratch);
+        for (int w = 0; w < words; w++) out[w] &= scratch[w];
+    }
+    if (filter->ward != -1) {
+        scanEqI32(bedColumns.ward, n, filter->ward, scratch);
+        for (int w = 0; w < words; w++) out[w] &= scratch[w];
+    }
+}
+
+// 将新床位加入床位存储: ID索引、列存储和链表, 成功返回1
+int bedStoreInsert(struct Bed* bed) {
+    if (!bedColumnsReserve(bedColumns.count + 1) || !bedBitmapsReserve()) {
+        return 0;
+    }
+    // 预先创建病房位图, 保证后续置位不会失败
+    if (getWardIndex(bed->ward) == NULL) {
+        return 0;
+    }
+    if (!bedIndexInsert(bed)) {
+        return 0;
+    }
+    if (!bedOrderInsert(bed)) {
+        bedIndexRemove(bed->ID);
+        return 0;
+    }
+    bed->slot = bedColumns.count++;
+    bedColumns.record[bed->slot] = bed;
+    bedColumnsSync(bed);
+    bedBitmapsSetSlot(bed->slot);
+    bedPageTouch(bed->slot);
+    linkBedAtHead(bed);
+    journalBed(bed);
+    return 1;
+}
+
+// 床位字段被修改后调用, 刷新各索引中的副本
+void bedStoreUpdate(struct Bed* bed) {
+    bedPageTouch(bed->slot);
+    bedBitmapsClearSlot(bed->slot);
+    bedColumnsSync(bed);
+    if (!bedBitmapsSetSlot(bed->slot)) {
+        printf("警告: 内存不足，病房 %d 的位图索引未更新\n", bed->ward);
+    }
+    journalBed(bed);
+}
+
+// 将床位从床位存储中移除 (不释放内存)
+void bedStoreRemove(struct Bed* bed) {
+    int i = bed->slot;
+    int last = bedColumns.count - 1;
+
+    bedIndexRemove(bed->ID);
+    bedOrderRemove(bed->ID);
+    bedPageTouch(i);        // 最后一个槽位的床位移入空出的槽位
+    bedPageTouch(last);
+    bedBitmapsClearSlot(i);
+    if (i != last) {
+        bedBitmapsClearSlot(last);
+    }
+    bedColumnsRemove(bed);
+    if (i != last) {
+        bedBitmapsSetSlot(i); // 被移动床位的病房位图已存在, 不会失败
+    }
+    unlinkBed(bed);
+    journalDelete(JournalBedDelete, bed->ID, 0);
+}
+
+// 为即将加入的beds个床位预先扩容各索引, 避免批量加载时反复扩容
+int bedStoreReserve(int beds) {
+    if (beds <= 0) {
+        return 1;
+    }
+    int target = bedIndex.count + beds;
+    if (!bedColumnsReserve(bedColumns.count + beds) || !bedBitmapsReserve()) {
+        return 0;
+    }
+    if (target * 2 > bedIndex.capacity) {
+        int capacity = bedIndex.capacity ? bedIndex.capacity : 64;
+        while (capacity < target * 2) {
+            capacity *= 2;
+        }
+        if (!bedIndexGrow(capacity)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// 在索引中查找病人ID所在的桶, 未找到时返回应插入的空桶位置
+int patientIndexProbe(int patientID) {
+    int mask = patientIndex.capacity - 1;
+    int i = (int)(hashInt(patientID) & (unsigned int)mask);
+    while (patientIndex.slots[i] != NULL && patientIndex.slots[i]->patient.patientID != patientID) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// 扩容并重新散列所有病人
+int patientIndexGrow(int newCapacity) {
+    struct PatientRecord** oldSlots = patientIndex.slots;
+    int oldCapacity = patientIndex.capacity;
+
+    struct PatientRecord** newSlots = (struct PatientRecord**)calloc(newCapacity, sizeof(struct PatientRecord*));
+    if (newSlots == NULL) {
+        return 0;
+    }
+
+    patientIndex.slots = newSlots;
+    patientIndex.capacity = newCapacity;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i] != NULL) {
+            patientIndex.slots[patientIndexProbe(oldSlots[i]->patient.patientID)] = oldSlots[i];
+        }
+    }
+    free(oldSlots);
+    return 1;
+}
+
+// 根据病人ID查找登记记录, O(1)
+struct PatientRecord* findPatientByID(int patientID) {
+    if (patientIndex.count == 0) {
+        return NULL;
+    }
+    return patientIndex.slots[patientIndexProbe(patientID)];
+}
+
+// 从索引中移除病人ID (向后移位删除, 不留墓碑)
+void patientIndexRemove(int patientID) {
+    if (patientIndex.count == 0) {
+        return;
+    }
+    int mask = patientIndex.capacity - 1;
+    int i = patientIndexProbe(patientID);
+    if (patientIndex.slots[i] == NULL) {
+        return;
+    }
+    patientIndex.slots[i] = NULL;
+    patientIndex.count--;
+
+    int j = (i + 1) & mask;
+    while (patientIndex.slots[j] != NULL) {
+        int home = (int)(hashInt(patientIndex.slots[j]->patient.patientID) & (unsigned int)mask);
+        if ((j > i && (home <= i || home > j)) || (j < i && (home <= i && home > j))) {
+            patientIndex.slots[i] = patientIndex.slots[j];
+            patientIndex.slots[j] = NULL;
+            i = j;
+        }
+        j = (j + 1) & mask;
+    }
+}
+
+// 为即将登记的patients个病人预先扩容索引和内存池
+int patientRegistryReserve(int patients) {
+    if (patients <= 0) {
+        return 1;
+    }
+    int target = patientIndex.count + patients;
+    if (target * 2 > patientIndex.capacity) {
+        int capacity = patientIndex.capacity ? patientIndex.capacity : 64;
+        while (capacity < target * 2) {
+            capacity *= 2;
+        }
+        if (!patientIndexGrow(capacity)) {
+            return 0;
+        }
+    }
+    return slabReserve(&patientPool, patients);
+}
+
+// 在索引中查找医生ID所在的桶, 未找到时返回应插入的空桶位置
+int doctorIndexProbe(int doctorID) {
+    int mask = doctorIndex.capacity - 1;
+    int i = (int)(hashInt(doctorID) & (unsigned int)mask);
+    while (doctorIndex.slots[i] != NULL && doctorIndex.slots[i]->doctorID != doctorID) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// 扩容并重新散列所有医生
+int doctorIndexGrow(int newCapacity) {
+    struct Doctor** oldSlots = doctorIndex.slots;
+    int oldCapacity = doctorIndex.capacity;
+
+    struct Doctor** newSlots = (struct Doctor**)calloc(newCapacity, sizeof(struct Doctor*));
+    if (newSlots == NULL) {
+        return 0;
+    }
+
+    doctorIndex.slots = newSlots;
+    doctorIndex.capacity = newCapacity;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i] != NULL) {
+            doctorIndex.slots[doctorIndexProbe(oldSlots[i]->doctorID)] = oldSlots[i];
+        }
+    }
+    free(oldSlots);
+    return 1;
+}
+
+// 根据医生ID查找医生, O(1)
+struct Doctor* findDoctorByID(int doctorID) {
+    if (doctorIndex.count == 0) {
+        return NULL;
+    }
+    return doctorIndex.slots[doctorIndexProbe(doctorID)];
+}
+
+// 从索引中移除医生ID (向后移位删除, 不留墓碑)
+void doctorIndexRemove(int doctorID) {
+    if (doctorIndex.count == 0) {
+        return;
+    }
+    int mask = doctorIndex.capacity - 1;
+    int i = doctorIndexProbe(doctorID);
+    if (doctorIndex.slots[i] == NULL) {
+        return;
+    }
+    doctorIndex.slots[i] = NULL;
+    doctorIndex.count--;
+
+    int j = (i + 1) & mask;
+    while (doctorIndex.slots[j] != NULL) {
+        int home = (int)(hashInt(doctorIndex.slots[j]->doctorID) & (unsigned int)mask);
+        if ((j > i && (home <= i || home > j)) || (j < i && (home <= i && home > j))) {
+            doctorIndex.slots[i] = doctorIndex.slots[j];
+            doctorIndex.slots[j] = NULL;
+            i = j;
+        }
+        j = (j + 1) & mask;
+    }
+}
+
+// 职称权重: 加权模式下负载按 病人数/权重 比较, 未知职称按1计
+int doctorLoadWeight(const struct Doctor* doctor) {
+    if (!doctorLoadWeighted || doctor->qualification < 1 || doctor->qualification > 4) {
+        return 1;
+    }
+    return doctor->qualification;
+}
+
+// 负载顺序: (加权)病人数少者优先, 相同时病人数少者优先, 再按医生ID
+int doctorLoadBefore(const struct Doctor* a, const struct Doctor* b) {
+    long long left = (long long)a->caseload * doctorLoadWeight(b);
+    long long right = (long long)b->caseload * doctorLoadWeight(a);
+    if (left != right) {
+        return left < right;
+    }
+    if (a->caseload != b->caseload) {
+        return a->caseload < b->caseload;
+    }
+    return a->doctorID < b->doctorID;
+}
+
+void doctorLoadSwap(struct DoctorLoadHeap* heap, int a, int b) {
+    struct Doctor* tmp = heap->items[a];
+    heap->items[a] = heap->items[b];
+    heap->items[b] = tmp;
+    heap->items[a]->loadPos = a;
+    heap->items[b]->loadPos = b;
+}
+
+void doctorLoadSiftUp(struct DoctorLoadHeap* heap, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!doctorLoadBefore(heap->items[i], heap->items[parent])) {
+            break;
+        }
+        doctorLoadSwap(heap, i, parent);
+        i = parent;
+    }
+}
+
+void doctorLoadSiftDown(struct DoctorLoadHeap* heap, int i) {
+    while (1) {
+        int best = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < heap->count && doctorLoadBefore(heap->items[left], heap->items[best])) {
+            best = left;
+        }
+        if (right < heap->count && doctorLoadBefore(heap->items[right], heap->items[best])) {
+            best = right;
+        }
+        if (best == i) {
+            break;
+        }
+        doctorLoadSwap(heap, i, best);
+        i = best;
+    }
+}
+
+// 将医生加入所属科室的负载堆, O(log d); 内存不足返回0
+int doctorLoadAdd(struct Doctor* doctor) {
+    struct DoctorLoadHeap* heap = &doctorLoadHeaps[departmentBitmapIndex(doctor->department)];
+    if (heap->count == heap->capacity) {
+        int newCapacity = heap->capacity ? heap->capacity * 2 : 8;
+        struct Doctor** items = (struct Doctor**)realloc(heap->items, newCapacity * sizeof(struct Doctor*));
+        if (items == NULL) {
+            return 0;
+        }
+        heap->items = items;
+        heap->capacity = newCapacity;
+    }
+    int i = heap->count++;
+    heap->items[i] = doctor;
+    doctor->loadPos = i;
+    doctorLoadSiftUp(heap, i);
+    return 1;
+}
+
+// 将医生移出所属科室的负载堆 (不在堆中时无操作), O(log d)
+void doctorLoadRemove(struct Doctor* doctor) {
+    if (doctor->loadPos < 0) {
+        return;
+    }
+    struct DoctorLoadHeap* heap = &doctorLoadHeaps[departmentBitmapIndex(doctor->department)];
+    int i = doctor->loadPos;
+    int last = --heap->count;
+    if (i != last) {
+        heap->items[i] = heap->items[last];
+        heap->items[i]->loadPos = i;
+        doctorLoadSiftDown(heap, i);
+        doctorLoadSiftUp(heap, i);
+    }
+    doctor->loadPos = -1;
+}
+
+// 医生负责的病人数变化delta后调整其在堆中的位置, O(log d)
+void doctorLoadChange(struct Doctor* doctor, int delta) {
+    struct DoctorLoadHeap* heap = &doctorLoadHeaps[departmentBitmapIndex(doctor->department)];
+    doctor->caseload += delta;
+    if (doctor->loadPos < 0) {
+        return;
+    }
+    if (delta > 0) {
+        doctorLoadSiftDown(heap, doctor->loadPos);
+    } else {
+        doctorLoadSiftUp(heap, doctor->loadPos);
+    }
+}
+
+// 切换是否按职称加权, 模式变化时就地重建各科室的堆, O(d)
+void doctorLoadSetWeighted(int weighted) {
+    weighted = weighted ? 1 : 0;
+    if (weighted == doctorLoadWeighted) {
+        return;
+    }
+    doctorLoadWeighted = weighted;
+    for (int d = 0; d <= DEPARTMENT_COUNT; d++) {
+        struct DoctorLoadHeap* heap = &doctorLoadHeaps[d];
+        for (int i = heap->count / 2 - 1; i >= 0; i--) {
+            doctorLoadSiftDown(heap, i);
+        }
+    }
+}
+
+// 将医生加入索引并链接到链表头部, 成功返回1, 内存不足返回0
+int doctorStoreInsert(struct Doctor* doctor) {
+    // 装载因子保持在0.5以下
+    if ((doctorIndex.count + 1) * 2 > doctorIndex.capacity) {
+        int newCapacity = doctorIndex.capacity ? doctorIndex.capacity * 2 : 64;
+        if (!doctorIndexGrow(newCapacity)) {
+            return 0;
+        }
+    }
+    // 关联可能先于医生存在 (如关联文件中引用了后来添加的医生ID)
+    doctor->caseload = adjacencyDegree(&doctorPatientByDoctor, doctor->doctorID);
+    if (!doctorLoadAdd(doctor)) {
+        return 0;
+    }
+    doctorIndex.slots[doctorIndexProbe(doctor->doctorID)] = doctor;
+    doctorIndex.count++;
+
+    doctor->prev = NULL;
+    doctor->next = doctorHead;
+    if (doctorHead != NULL) {
+        doctorHead->prev = doctor;
+    }
+    doctorHead = doctor;
+    journalDoctor(doctor);
+    return 1;
+}
+
+// 将医生从索引和链表中移除 (不释放内存)
+void doctorStoreRemove(struct Doctor* doctor) {
+    doctorIndexRemove(doctor->doctorID);
+    doctorLoadRemove(doctor);
+    if (doctor->prev != NULL) {
+        doctor->prev->next = doctor->next;
+    } else {
+        doctorHead = doctor->next;
+    }
+    if (doctor->next != NULL) {
+        doctor->next->prev = doctor->prev;
+    }
+    journalDelete(JournalDoctorDelete, doctor->doctorID, 0);
+}
+
+// 为即将加入的doctors个医生预先扩容索引 (医生对象由调用者分配)
+int doctorStoreReserve(int doctors) {
+    if (doctors <= 0) {
+        return 1;
+    }
+    int target = doctorIndex.count + doctors;
+    if (target * 2 > doctorIndex.capacity) {
+        int capacity = doctorIndex.capacity ? doctorIndex.capacity : 64;
+        while (capacity < target * 2) {
+            capacity *= 2;
+        }
+        if (!doctorIndexGrow(capacity)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// 查找键所在的桶, 未找到时返回应插入的空桶位置
+// 关系在段内的位置 (段搬迁和压缩都保持段内顺序, 因此只在加入和交换删除时更新)
+int* adjacencyPos(const struct AdjacencyIndex* index, void* edge) {
+    return (int*)((char*)edge + index->posOffset);
+}
+
+int adjacencyProbe(const struct AdjacencyIndex* index, int key) {
+    int mask = index->segmentCapacity - 1;
+    int i = (int)(hashInt(key) & (unsigned int)mask);
+    while (index->segments[i].used && index->segments[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// 返回键对应的关系指针数组及数量, 没有关系时返回NULL (数组在索引修改后失效)
+void** adjacencyEdges(const struct AdjacencyIndex* index, int key, int* count) {
+    *count = 0;
+    if (index->segmentCount == 0) {
+        return NULL;
+    }
+    const struct AdjacencySegment* segment = &index->segments[adjacencyProbe(index, key)];
+    if (!segment->used || segment->count == 0) {
+        return NULL;
+    }
+    *count = segment->count;
+    return index->edges + segment->offset;
+}
+
+// 键对应的关系数量, O(1)
+int adjacencyDegree(const struct AdjacencyIndex* index, int key) {
+    int count;
+    adjacencyEdges(index, key, &count);
+    return count;
+}
+
+// 按紧凑布局重建索引: 各段按顺序排列、没有空洞和空余, 并丢弃没有关系的键
+int adjacencyCompact(struct AdjacencyIndex* index) {
+    int live = 0;
+    int edges = 0;
+    for (int i = 0; i < index->segmentCapacity; i++) {
+        if (index->segments[i].used && index->segments[i].count > 0) {
+            live++;
+            edges += index->segments[i].count;
+        }
+    }
+    // 重建后装载因子不超过1/4, 为后续插入留出余量
+    int segmentCapacity = 64;
+    while (segmentCapacity < (live + 1) * 4) {
+        segmentCapacity *= 2;
+    }
+    struct AdjacencySegment* segments = (struct AdjacencySegment*)calloc(segmentCapacity, sizeof(struct AdjacencySegment));
+    void** packed = (void**)malloc((edges > 0 ? edges : 1) * sizeof(void*));
+    if (segments == NULL || packed == NULL) {
+        free(segments);
+        free(packed);
+        return 0;
+    }
+
+    struct AdjacencyIndex compacted = {segments, segmentCapacity, live, packed, 0, edges, 0, index->posOffset};
+    for (int i = 0; i < index->segmentCapacity; i++) {
+        const struct AdjacencySegment* old = &index->segments[i];
+        if (!old->used || old->count == 0) {
+            continue;
+        }
+        struct AdjacencySegment* segment = &segments[adjacencyProbe(&compacted, old->key)];
+        segment->key = old->key;
+        segment->used = 1;
+        segment->offset = compacted.edgeCount;
+        segment->count = old->count;
+        segment->capacity = old->count;
+        memcpy(packed + compacted.edgeCount, index->edges + old->offset, old->count * sizeof(void*));
+        compacted.edgeCount += old->count;
+    }
+    free(index->segments);
+    free(index->edges);
+    *index = compacted;
+    return 1;
+}
+
+// 确保edges末尾还有extra个空位
+int adjacencyReserveEdges(struct AdjacencyIndex* index, int extra) {
+    if (index->edgeCount + extra <= index->edgeCapacity) {
+        return 1;
+    }
+    int newCapacity = index->edgeCapacity ? index->edgeCapacity * 2 : 64;
+    while (newCapacity < index->edgeCount + extra) {
+        newCapacity *= 2;
+    }
+    void** edges = (void**)realloc(index->edges, newCapacity * sizeof(void*));
+    if (edges == NULL) {
+        return 0;
+    }
+    index->edges = edges;
+    index->edgeCapacity = newCapacity;
+    return 1;
+}
+
+// 将关系加入键对应的段, 均摊O(1); 内存不足返回0且索引不变
+int adjacencyAdd(struct AdjacencyIndex* index, int key, void* edge) {
+    // 装载因子超过1/2时借助压缩重建散列表, 同时丢弃已没有关系的键
+    if ((index->segmentCount + 1) * 2 > index->segmentCapacity && !adjacencyCompact(index)) {
+        return 0;
+    }
+
+    struct AdjacencySegment* segment = &index->segments[adjacencyProbe(index, key)];
+    if (!segment->used) {
+        segment->key = key;
+        segment->used = 1;
+        segment->offset = index->edgeCount;
+        segment->count = 0;
+        segment->capacity = 0;
+        index->segmentCount++;
+    }
+
+    if (segment->count == segment->capacity) {
+        int newCapacity = segment->capacity ? segment->capacity * 2 : 2;
+        if (segment->capacity > 0 && segment->offset + segment->capacity == index->edgeCount) {
+            // 段位于edges末尾, 原地扩展
+            if (!adjacencyReserveEdges(index, newCapacity - segment->capacity)) {
+                return 0;
+            }
+        } else {
+            // 搬到edges末尾, 原位置成为空洞
+            if (!adjacencyReserveEdges(index, newCapacity)) {
+                return 0;
+            }
+            memcpy(index->edges + index->edgeCount, index->edges + segment->offset, segment->count * sizeof(void*));
+            index->wasted += segment->capacity;
+            segment->offset = index->edgeCount;
+        }
+        index->edgeCount = segment->offset + newCapacity;
+        segment->capacity = newCapacity;
+    }
+    *adjacencyPos(index, edge) = segment->count;
+    index->edges[segment->offset + segment->count++] = edge;
+
+    // 空洞超过一半时压缩 (失败时保持原布局, 不影响正确性)
+    if (index->wasted > 64 && index->wasted * 2 > index->edgeCount) {
+        adjacencyCompact(index);
+    }
+    return 1;
+}
+
+// 从键对应的段中删除关系 (与段内最后一个交换), O(1)
+void adjacencyRemove(struct AdjacencyIndex* index, int key, void* edge) {
+    if (index->segmentCount == 0) {
+        return;
+    }
+    struct AdjacencySegment* segment = &index->segments[adjacencyProbe(index, key)];
+    if (!segment->used) {
+        return;
+    }
+    void** edges = index->edges + segment->offset;
+    int i = *adjacencyPos(index, edge);
+    if (i < 0 || i >= segment->count || edges[i] != edge) {
+        return;
+    }
+    edges[i] = edges[--segment->count];
+    *adjacencyPos(index, edges[i]) = i;
+}
+
+void adjacencyFree(struct AdjacencyIndex* index) {
+    size_t posOffset = index->posOffset;
+    free(index->segments);
+    free(index->edges);
+    memset(index, 0, sizeof(*index));
+    index->posOffset = posOffset;
+}
+
+// 将两个ID打包为复合键
+unsigned long long relationKey(int doctorID, int otherID) {
+    return ((unsigned long long)(unsigned int)doctorID << 32) | (unsigned int)otherID;
+}
+
+// 查找复合键所在的桶, 未找到时返回应插入的空桶位置
+int relationSetProbe(struct RelationSet* set, unsigned long long key) {
+    int mask = set->capacity - 1;
+    int i = (int)(hashGram(key) & (unsigned int)mask);
+    while (set->slots[i].relation != NULL && set->slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// 扩容并重新散列所有键
+int relationSetGrow(struct RelationSet* set, int newCapacity) {
+    struct RelationSlot* oldSlots = set->slots;
+    int oldCapacity = set->capacity;
+
+    struct RelationSlot* newSlots = (struct RelationSlot*)calloc(newCapacity, sizeof(struct RelationSlot));
+    if (newSlots == NULL) {
+        return 0;
+    }
+
+    set->slots = newSlots;
+    set->capacity = newCapacity;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].relation != NULL) {
+            set->slots[relationSetProbe(set, oldSlots[i].key)] = oldSlots[i];
+        }
+    }
+    free(oldSlots);
+    return 1;
+}
+
+// 为即将加入的relations个键预先扩容, 装载因子保持在0.5以下
+int relationSetReserve(struct RelationSet* set, int relations) {
+    int target = set->count + relations;
+    if (target * 2 <= set->capacity) {
+        return 1;
+    }
+    int capacity = set->capacity ? set->capacity : 64;
+    while (capacity < target * 2) {
+        capacity *= 2;
+    }
+    return relationSetGrow(set, capacity);
+}
+
+// 查找复合键对应的关联, 不存在时返回NULL
+void* relationSetFind(struct RelationSet* set, unsigned long long key) {
+    if (set->count == 0) {
+        return NULL;
+    }
+    return set->slots[relationSetProbe(set, key)].relation;
+}
+
+// 加入复合键, 调用方保证键不存在; 内存不足返回0
+int relationSetAdd(struct RelationSet* set, unsigned long long key, void* relation) {
+    if (!relationSetReserve(set, 1)) {
+        return 0;
+    }
+    struct RelationSlot* slot = &set->slots[relationSetProbe(set, key)];
+    slot->key = key;
+    slot->relation = relation;
+    set->count++;
+    return 1;
+}
+
+// 移除复合键 (向后移位删除, 不留墓碑)
+void relationSetRemove(struct RelationSet* set, unsigned long long key) {
+    if (set->count == 0) {
+        return;
+    }
+    int mask = set->capacity - 1;
+    int i = relationSetProbe(set, key);
+    if (set->slots[i].relation == NULL) {
+        return;
+    }
+    set->slots[i].relation = NULL;
+    set->count--;
+
+    int j = (i + 1) & mask;
+    while (set->slots[j].relation != NULL) {
+        int home = (int)(hashGram(set->slots[j].key) & (unsigned int)mask);
+        if ((j > i && (home <= i || home > j)) || (j < i && (home <= i && home > j))) {
+            set->slots[i] = set->slots[j];
+            set->slots[j].relation = NULL;
+            i = j;
+        }
+        j = (j + 1) & mask;
+    }
+}
+
+void relationSetFree(struct RelationSet* set) {
+    free(set->slots);
+    memset(set, 0, sizeof(*set));
+}
+
+// 将医生-病人关联加入链表、查重集合和邻接索引, 内存不足返回0且不做任何修改
+int doctorPatientLink(struct DoctorPatientRelation* relation) {
+    unsigned long long key = relationKey(relation->doctorID, relation->patientID);
+    if (!relationSetAdd(&doctorPatientPairs, key, relation)) {
+        return 0;
+    }
+    if (!adjacencyAdd(&doctorPatientByDoctor, relation->doctorID, relation)) {
+        relationSetRemove(&doctorPatientPairs, key);
+        return 0;
+    }
+    if (!adjacencyAdd(&doctorPatientByPatient, relation->patientID, relation)) {
+        adjacencyRemove(&doctorPatientByDoctor, relation->doctorID, relation);
+        relationSetRemove(&doctorPatientPairs, key);
+        return 0;
+    }
+    relation->prev = NULL;
+    relation->next = doctorPatientHead;
+    if (doctorPatientHead != NULL) {
+        doctorPatientHead->prev = relation;
+    }
+    doctorPatientHead = relation;
+
+    struct Doctor* doctor = findDoctorByID(relation->doctorID);
+    if (doctor != NULL) {
+        doctorLoadChange(doctor, 1);
+    }
+    journalDoctorPatient(relation);
+    return 1;
+}
+
+// 将医生-病人关联从链表、查重集合和邻接索引中移除 (不释放内存)
+void doctorPatientUnlink(struct DoctorPatientRelation* relation) {
+    relationSetRemove(&doctorPatientPairs, relationKey(relation->doctorID, relation->patientID));
+    struct Doctor* doctor = findDoctorByID(relation->doctorID);
+    if (doctor != NULL) {
+        doctorLoadChange(doctor, -1);
+    }
+    adjacencyRemove(&doctorPatientByDoctor, relation->doctorID, relation);
+    adjacencyRemove(&doctorPatientByPatient, relation->patientID, relation);
+    if (relation->prev != NULL) {
+        relation->prev->next = relation->next;
+    } else {
+        doctorPatientHead = relation->next;
+    }
+    if (relation->next != NULL) {
+        relation->next->prev = relation->prev;
+    }
+    journalDelete(JournalDoctorPatientDelete, relation->doctorID, relation->patientID);
+}
+
+// 查找指定医生与病人的关联, 不存在时返回NULL, O(1)
+struct DoctorPatientRelation* findDoctorPatientRelation(int doctorID, int patientID) {
+    return (struct DoctorPatientRelation*)relationSetFind(&doctorPatientPairs, relationKey(doctorID, patientID));
+}
+
+// 将医生-病房关联加入链表、查重集合和邻接索引, 内存不足返回0且不做任何修改
+int doctorWardLink(struct DoctorWardRelation* relation) {
+    unsigned long long key = relationKey(relation->doctorID, relation->wardNumber);
+    if (!relationSetAdd(&doctorWardPairs, key, relation)) {
+        return 0;
+    }
+    if (!adjacencyAdd(&doctorWardByDoctor, relation->doctorID, relation)) {
+        relationSetRemove(&doctorWardPairs, key);
+        return 0;
+    }
+    if (!adjacencyAdd(&doctorWardByWard, relation->wardNumber, relation)) {
+        adjacencyRemove(&doctorWardByDoctor, relation->doctorID, relation);
+        relationSetRemove(&doctorWardPairs, key);
+        return 0;
+    }
+    relation->prev = NULL;
+    relation->next = doctorWardHead;
+    if (doctorWardHead != NULL) {
+        doctorWardHead->prev = relation;
+    }
+    doctorWardHead = relation;
+    journalDoctorWard(relation);
+    return 1;
+}
+
+// 将医生-病房关联从链表、查重集合和邻接索引中移除 (不释放内存)
+void doctorWardUnlink(struct DoctorWardRelation* relation) {
+    relationSetRemove(&doctorWardPairs, relationKey(relation->doctorID, relation->wardNumber));
+    adjacencyRemove(&doctorWardByDoctor, relation->doctorID, relation);
+    adjacencyRemove(&doctorWardByWard, relation->wardNumber, relation);
+    if (relation->prev != NULL) {
+        relation->prev->next = relation->next;
+    } else {
+        doctorWardHead = relation->next;
+    }
+    if (relation->next != NULL) {
+        relation->next->prev = relation->prev;
+    }
+    journalDelete(JournalDoctorWardDelete, relation->doctorID, relation->wardNumber);
+}
+
+// 查找指定医生与病房的关联, 不存在时返回NULL, O(1)
+struct DoctorWardRelation* findDoctorWardRelation(int doctorID, int wardNumber) {
+    return (struct DoctorWardRelation*)relationSetFind(&doctorWardPairs, relationKey(doctorID, wardNumber));
+}
+
+#define DOCTOR_PATIENT_ARCHIVE "doctor_patient_history.csv"  // 已解除的医生-病人关联归档
+
+// 以追加方式打开关联归档文件 (新文件先写入表头), 失败返回NULL
+FILE* openRelationArchive() {
+    FILE* file = fopen(DOCTOR_PATIENT_ARCHIVE, "a");
+    if (file == NULL) {
+        printf("警告: 无法打开归档文件 %s，解除的关联将不被归档\n", DOCTOR_PATIENT_ARCHIVE);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0) {
+        fprintf(file, "doctorID,patientID,notes,startDate,endDate\n");
+    }
+    return file;
+}
+
+// 当天日期 (YYYY-MM-DD), 作为归档关联的结束日期
+void formatToday(char* buffer, size_t size) {
+    time_t now = time(NULL);
+    strftime(buffer, size, "%Y-%m-%d", localtime(&now));
+}
+
+// 向归档文件写入一条医生-病人关联
+void archiveDoctorPatientRelation(FILE* archive, const struct DoctorPatientRelation* relation, const char* endDate) {
+    if (archive != NULL) {
+        char notes[2 * sizeof(relation->notes)], startDate[2 * sizeof(relation->startDate)];
+        fprintf(archive, "%d,%d,\"%s\",\"%s\",%s\n", relation->doctorID, relation->patientID,
+                csvEscape(relation->notes, notes), csvEscape(relation->startDate, startDate), endDate);
+    }
+}
+
+// 归档医生-病人关联后将其从链表和各索引中删除并释放
+void retireDoctorPatientRelation(FILE* archive, struct DoctorPatientRelation* relation, const char* endDate) {
+    archiveDoctorPatientRelation(archive, relation, endDate);
+    doctorPatientUnlink(relation);
+    slabFree(&doctorPatientPool, relation);
+}
+
+// 病人出院后级联解除其全部医生关联并归档, O(度数); 返回解除的数量
+int cascadePatientRelations(int patientID) {
+    int degree;
+    void** edges = adjacencyEdges(&doctorPatientByPatient, patientID, &degree);
+    if (degree == 0) {
+        return 0;
+    }
+    FILE* archive = openRelationArchive();
+    char today[20];
+    formatToday(today, sizeof(today));
+    int removed = 0;
+    // 每次删除段内最后一条, 段内无需移动
+    while (edges != NULL) {
+        retireDoctorPatientRelation(archive, (struct DoctorPatientRelation*)edges[degree - 1], today);
+        removed++;
+        edges = adjacencyEdges(&doctorPatientByPatient, patientID, &degree);
+    }
+    if (archive != NULL) {
+        fclose(archive);
+    }
+    return removed;
+}
+
+// 删除医生前级联解除其全部病人关联 (归档) 和病房关联, O(度数)
+void cascadeDoctorRelations(int doctorID, int* patients, int* wards) {
+    int degree;
+    void** edges = adjacencyEdges(&doctorPatientByDoctor, doctorID, &degree);
+    *patients = 0;
+    if (edges != NULL) {
+        FILE* archive = openRelationArchive();
+        char today[20];
+        formatToday(today, sizeof(today));
+        while (edges != NULL) {
+            retireDoctorPatientRelation(archive, (struct DoctorPatientRelation*)edges[degree - 1], today);
+            (*patients)++;
+            edges = adjacencyEdges(&doctorPatientByDoctor, doctorID, &degree);
+        }
+        if (archive != NULL) {
+            fclose(archive);
+        }
+    }
+
+    *wards = 0;
+    while ((edges = adjacencyEdges(&doctorWardByDoctor, doctorID, &degree)) != NULL) {
+        struct DoctorWardRelation* relation = (struct DoctorWardRelation*)edges[degree - 1];
+        doctorWardUnlink(relation);
+        slabFree(&doctorWardPool, relation);
+        (*wards)++;
+    }
+}
+
+// 病人表是否完整加载 (床位和病人数据都存在, 且没有记录被跳过或未能加载).
+// 只有完整时才能断定关联的病人已不存在, 否则保留这些关联, 避免数据文件缺失或损坏时误删
+int patientTableComplete = 0;
+
+// 启动时归档病人已不存在的遗留医生-病人关联 (病人已出院或被删除), O(关联数); 返回归档的数量
+int archiveOrphanRelations() {
+    FILE* archive = NULL;
+    char today[20];
+    formatToday(today, sizeof(today));
+    int archived = 0;
+    struct DoctorPatientRelation* relation = doctorPatientHead;
+    while (relation != NULL) {
+        struct DoctorPatientRelation* next = relation->next;
+        if (findPatientByID(relation->patientID) == NULL) {
+            if (archived == 0) {
+                archive = openRelationArchive();
+            }
+            retireDoctorPatientRelation(archive, relation, today);
+            archived++;
+        }
+        relation = next;
+    }
+    if (archive != NULL) {
+        fclose(archive);
+    }
+    return archived;
+}
+
+// 解码一个UTF-8字符, 返回占用的字节数; 非法字节按单字节处理
+int utf8Decode(const unsigned char* s, unsigned int* codePoint) {
+    int length;
+    unsigned int cp;
+    if (s[0] < 0x80) {
+        *codePoint = s[0];
+        return 1;
+    } else if ((s[0] & 0xE0) == 0xC0) {
+        length = 2;
+        cp = s[0] & 0x1F;
+    } else if ((s[0] & 0xF0) == 0xE0) {
+        length = 3;
+        cp = s[0] & 0x0F;
+    } else if ((s[0] & 0xF8) == 0xF0) {
+        length = 4;
+        cp = s[0] & 0x07;
+    } else {
+        *codePoint = s[0];
+        return 1;
+    }
+    for (int i = 1; i < length; i++) {
+        if ((s[i] & 0xC0) != 0x80) {
+            *codePoint = s[0];
+            return 1;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+    *codePoint = cp;
+    return length;
+}
+
+// 将文本解码为码点序列, 返回字符数
+int textToCodePoints(const char* text, unsigned int* out, int max) {
+    const unsigned char* p = (const unsigned char*)text;
+    int n = 0;
+    while (*p != '\0' && n < max) {
+        p += utf8Decode(p, &out[n++]);
+    }
+    return n;
+}
+
+#define GRAM_KEY_USED (1ULL << 63)  // 所有元组键都置此位, 0留作空桶标记
+#define GRAM_CODE_POINT_MAX 0xFFFFF  // 每个码点占20位, 更大的码点 (第15、16辅助平面) 合并为同一个值
+
+// 由字段编号和1~3个码点组成元组键 (缺少的位置为0). 合并的码点只会增加候选病人, 结果仍经逐条比对
+unsigned long long gramKey(int field, unsigned int a, unsigned int b, unsigned int c) {
+    a = a > GRAM_CODE_POINT_MAX ? GRAM_CODE_POINT_MAX : a;
+    b = b > GRAM_CODE_POINT_MAX ? GRAM_CODE_POINT_MAX : b;
+    c = c > GRAM_CODE_POINT_MAX ? GRAM_CODE_POINT_MAX : c;
+    return GRAM_KEY_USED | ((unsigned long long)field << 60) | ((unsigned long long)a << 40) |
+           ((unsigned long long)b << 20) | (unsigned long long)c;
+}
+
+// 查找元组所在的桶, 未找到时返回应插入的空桶位置
+int textIndexProbe(unsigned long long key) {
+    int mask = textIndex.capacity - 1;
+    int i = (int)(hashGram(key) & (unsigned int)mask);
+    while (textIndex.slots[i].key != 0 && textIndex.slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+int textIndexGrow(int newCapacity) {
+    struct GramPosting* oldSlots = textIndex.slots;
+    int oldCapacity = textIndex.capacity;
+
+    struct GramPosting* newSlots = (struct GramPosting*)calloc(newCapacity, sizeof(struct GramPosting));
+    if (newSlots == NULL) {
+        return 0;
+    }
+
+    textIndex.slots = newSlots;
+    textIndex.capacity = newCapacity;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].key != 0) {
+            textIndex.slots[textIndexProbe(oldSlots[i].key)] = oldSlots[i];
+        }
+    }
+    free(oldSlots);
+    return 1;
+}
+
+// 查找元组的倒排表, 不存在时返回NULL
+struct GramPosting* findGramPosting(unsigned long long key) {
+    if (textIndex.count == 0) {
+        return NULL;
+    }
+    struct GramPosting* posting = &textIndex.slots[textIndexProbe(key)];
+    return posting->key != 0 ? posting : NULL;
+}
+
+// 提取一个字段的全部元组键, 返回键数量 (可能有重复)
+int collectGrams(int field, const char* text, unsigned long long* out) {
+    unsigned int cps[TEXT_MAX_CHARS + 1];
+    cps[0] = TEXT_GRAM_BEGIN;
+    int n = textToCodePoints(text, cps + 1, TEXT_MAX_CHARS) + 1;
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        if (i > 0) {
+            out[count++] = gramKey(field, cps[i], 0, 0);
+        }
+        if (i + 1 < n) {
+            out[count++] = gramKey(field, cps[i], cps[i + 1], 0);
+        }
+        if (i + 2 < n) {
+            out[count++] = gramKey(field, cps[i], cps[i + 1], cps[i + 2]);
+        }
+    }
+    return count;
+}
+
+int compareGramKeys(const void* a, const void* b) {
+    unsigned long long x = *(const unsigned long long*)a;
+    unsigned long long y = *(const unsigned long long*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// 提取病人姓名和诊断的元组键, 排序去重后返回键数量
+int collectRecordGrams(const struct PatientRecord* record, unsigned long long* out) {
+    int count = collectGrams(TEXT_FIELD_NAME, record->patient.name, out);
+    count += collectGrams(TEXT_FIELD_DIAGNOSIS, record->patient.diagnosis, out + count);
+    qsort(out, count, sizeof(unsigned long long), compareGramKeys);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || out[unique - 1] != out[i]) {
+            out[unique++] = out[i];
+        }
+    }
+    return unique;
+}
+
+// 将病人加入文本索引; 内存不足时标记索引不完整
+void textIndexAdd(struct PatientRecord* record) {
+    unsigned long long grams[2 * 3 * (TEXT_MAX_CHARS + 1)];
+    int n = collectRecordGrams(record, grams);
+    for (int g = 0; g < n; g++) {
+        if ((textIndex.count + 1) * 2 > textIndex.capacity) {
+            int newCapacity = textIndex.capacity ? textIndex.capacity * 2 : 1024;
+            if (!textIndexGrow(newCapacity)) {
+                textIndex.incomplete = 1;
+                return;
+            }
+        }
+        struct GramPosting* posting = &textIndex.slots[textIndexProbe(grams[g])];
+        if (posting->key == 0) {
+            posting->key = grams[g];
+            textIndex.count++;
+        }
+        if (posting->count == posting->capacity) {
+            int newCapacity = posting->capacity ? posting->capacity * 2 : 4;
+            struct PatientRecord** items = (struct PatientRecord**)realloc(posting->items, newCapacity * sizeof(struct PatientRecord*));
+            if (items == NULL) {
+                textIndex.incomplete = 1;
+                return;
+            }
+            posting->items = items;
+            posting->capacity = newCapacity;
+        }
+        posting->items[posting->count++] = record;
+    }
+}
+
+// 将病人移出文本索引 (倒排表中从后向前查找并交换删除)
+void textIndexRemove(struct PatientRecord* record) {
+    unsigned long long grams[2 * 3 * (TEXT_MAX_CHARS + 1)];
+    int n = collectRecordGrams(record, grams);
+    for (int g = 0; g < n; g++) {
+        struct GramPosting* posting = findGramPosting(grams[g]);
+        if (posting == NULL) {
+            continue;
+        }
+        for (int i = posting->count - 1; i >= 0; i--) {
+            if (posting->items[i] == record) {
+                posting->items[i] = posting->items[--posting->count];
+                break;
+            }
+        }
+    }
+}
+
+void textIndexFree() {
+    for (int i = 0; i < textIndex.capacity; i++) {
+        free(textIndex.slots[i].items);
+    }
+    free(textIndex.slots);
+    memset(&textIndex, 0, sizeof(textIndex));
+}
+
+// 检查字段文本是否匹配查询 (prefix为1时要求以查询开头)
+int textMatches(const char* text, const char* query, int prefix) {
+    if (prefix) {
+        return strncmp(text, query, strlen(query)) == 0;
+    }
+    return strstr(text, query) != NULL;
+}
+
+// 选出查询所需元组中倒排表最短的一个作为候选集, 返回NULL表示没有病人可能匹配
+// 查询不足3个字符时直接使用对应的1元组或2元组
+struct GramPosting* textIndexCandidates(int field, const char* query, int prefix) {
+    unsigned int cps[TEXT_MAX_CHARS + 1];
+    int start = prefix ? 0 : 1;
+    cps[0] = TEXT_GRAM_BEGIN;
+    int n = textToCodePoints(query, cps + 1, TEXT_MAX_CHARS) + 1;
+
+    struct GramPosting* best = NULL;
+    for (int i = start; i < n; i++) {
+        int len = n - i < 3 ? n - i : 3;
+        if (len < 3 && i > start) {
+            break; // 较长查询的末尾已被前面的3元组覆盖
+        }
+        unsigned long long key = gramKey(field, cps[i], len > 1 ? cps[i + 1] : 0, len > 2 ? cps[i + 2] : 0);
+        struct GramPosting* posting = findGramPosting(key);
+        if (posting == NULL || posting->count == 0) {
+            return NULL;
+        }
+        if (best == NULL || posting->count < best->count) {
+            best = posting;
+        }
+    }
+    return best;
+}
+
+// 返回子节点链表中首字符为c的节点所在的链接位置 (不存在时为应插入的位置)
+struct PhoneTrieNode** phoneTrieChildLink(struct PhoneTrieNode* node, char c) {
+    struct PhoneTrieNode** link = &node->child;
+    while (*link != NULL && (unsigned char)(*link)->label[0] < (unsigned char)c) {
+        link = &(*link)->sibling;
+    }
+    return link;
+}
+
+// 将号码插入基数树, 内存不足返回0且树不变
+int phoneTrieInsert(struct PhoneTrieNode* root, const char* key, int length, int kind, void* owner) {
+    // 一次插入至多拆分一个节点并新建一个叶子, 预先分配好以免中途失败
+    struct PhoneEntry* entry = (struct PhoneEntry*)slabAlloc(&phoneEntryPool);
+    struct PhoneTrieNode* spare[2];
+    spare[0] = (struct PhoneTrieNode*)slabAlloc(&phoneNodePool);
+    spare[1] = (struct PhoneTrieNode*)slabAlloc(&phoneNodePool);
+    if (entry == NULL || spare[0] == NULL || spare[1] == NULL) {
+        if (entry != NULL) {
+            slabFree(&phoneEntryPool, entry);
+        }
+        for (int k = 0; k < 2; k++) {
+            if (spare[k] != NULL) {
+                slabFree(&phoneNodePool, spare[k]);
+            }
+        }
+        return 0;
+    }
+
+    struct PhoneTrieNode* node = root;
+    int used = 0;
+    int i = 0;
+    while (i < length) {
+        struct PhoneTrieNode** link = phoneTrieChildLink(node, key[i]);
+        struct PhoneTrieNode* child = *link;
+        if (child == NULL || child->label[0] != key[i]) {
+            // 没有共同前缀的子节点: 剩余部分作为新叶子
+            struct PhoneTrieNode* leaf = spare[used++];
+            memcpy(leaf->label, key + i, length - i);
+            leaf->labelLength = length - i;
+            leaf->count = 0;
+            leaf->child = NULL;
+            leaf->entries = NULL;
+            leaf->sibling = child;
+            *link = leaf;
+            node->count++;
+            node = leaf;
+            break;
+        }
+        int m = 1;
+        while (m < child->labelLength && i + m < length && child->label[m] == key[i + m]) {
+            m++;
+        }
+        if (m < child->labelLength) {
+            // 只匹配了边的一部分: 拆出公共部分作为中间节点
+            struct PhoneTrieNode* mid = spare[used++];
+            memcpy(mid->label, child->label, m);
+            mid->labelLength = m;
+            mid->count = child->count;
+            mid->entries = NULL;
+            mid->child = child;
+            mid->sibling = child->sibling;
+            *link = mid;
+            memmove(child->label, child->label + m, child->labelLength - m);
+            child->labelLength -= m;
+            child->sibling = NULL;
+            child = mid;
+        }
+        node->count++;
+        node = child;
+        i += m;
+    }
+
+    node->count++;
+    entry->kind = kind;
+    entry->owner = owner;
+    entry->next = node->entries;
+    node->entries = entry;
+    for (; used < 2; used++) {
+        slabFree(&phoneNodePool, spare[used]);
+    }
+    return 1;
+}
+
+// 从基数树中删除号码条目, 并删除空叶子、合并只剩一个子节点的中间节点
+void phoneTrieRemove(struct PhoneTrieNode* root, const char* key, int length, int kind, void* owner) {
+    struct PhoneTrieNode* path[PHONE_KEY_MAX + 1];
+    struct PhoneTrieNode** links[PHONE_KEY_MAX + 1];
+    int depth = 0;
+    int i = 0;
+    path[0] = root;
+    links[0] = NULL;
+    while (i < length) {
+        struct PhoneTrieNode** link = phoneTrieChildLink(path[depth], key[i]);
+        struct PhoneTrieNode* child = *link;
+        if (child == NULL || child->labelLength > length - i ||
+            memcmp(child->label, key + i, child->labelLength) != 0) {
+            return; // 号码不在树中
+        }
+        i += child->labelLength;
+        depth++;
+        path[depth] = child;
+        links[depth] = link;
+    }
+
+    struct PhoneTrieNode* node = path[depth];
+    struct PhoneEntry** entry = &node->entries;
+    while (*entry != NULL && ((*entry)->kind != kind || (*entry)->owner != owner)) {
+        entry = &(*entry)->next;
+    }
+    if (*entry == NULL) {
+        return;
+    }
+    struct PhoneEntry* removed = *entry;
+    *entry = removed->next;
+    slabFree(&phoneEntryPool, removed);
+    for (int d = 0; d <= depth; d++) {
+        path[d]->count--;
+    }
+
+    // 子树为空的节点没有子节点, 直接删除, 然后检查其父节点
+    if (depth > 0 && node->count == 0) {
+        *links[depth] = node->sibling;
+        slabFree(&phoneNodePool, node);
+        node = path[--depth];
+    }
+    // 没有条目且只剩一个子节点的中间节点与子节点合并
+    if (depth > 0 && node->entries == NULL && node->child != NULL && node->child->sibling == NULL) {
+        struct PhoneTrieNode* child = node->child;
+        memcpy(node->label + node->labelLength, child->label, child->labelLength);
+        node->labelLength += child->labelLength;
+        node->entries = child->entries;
+        node->child = child->child;
+        slabFree(&phoneNodePool, child);
+    }
+}
+
+// 查找以key开头的所有号码所在的子树, 不存在时返回NULL
+struct PhoneTrieNode* phoneTrieLocate(struct PhoneTrieNode* root, const char* key, int length) {
+    struct PhoneTrieNode* node = root;
+    int i = 0;
+    while (i < length) {
+        struct PhoneTrieNode* child = *phoneTrieChildLink(node, key[i]);
+        if (child == NULL || child->label[0] != key[i]) {
+            return NULL;
+        }
+        int m = child->labelLength < length - i ? child->labelLength : length - i;
+        if (memcmp(child->label, key + i, m) != 0) {
+            return NULL;
+        }
+        i += m;
+        node = child;
+    }
+    return node;
+}
+
+// 按号码顺序收集子树中的条目, 至多limit个, 返回收集后的数量
+int phoneTrieCollect(struct PhoneTrieNode* node, struct PhoneEntry** out, int n, int limit) {
+    for (struct PhoneEntry* entry = node->entries; entry != NULL && n < limit; entry = entry->next) {
+        out[n++] = entry;
+    }
+    for (struct PhoneTrieNode* child = node->child; child != NULL && n < limit; child = child->sibling) {
+        n = phoneTrieCollect(child, out, n, limit);
+    }
+    return n;
+}
+
+// 将字符串逆序写入buffer, 返回长度 (至多PHONE_KEY_MAX-1个字符)
+int reversePhone(const char* phone, char* buffer) {
+    int length = 0;
+    while (length < PHONE_KEY_MAX - 1 && phone[length] != '\0') {
+        length++;
+    }
+    for (int i = 0; i < length; i++) {
+        buffer[i] = phone[length - 1 - i];
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+// 将号码加入正序和逆序两棵树, 空号码不索引
+void phoneIndexAdd(const char* phone, int kind, void* owner) {
+    char reversed[PHONE_KEY_MAX];
+    int length = reversePhone(phone, reversed);
+    if (length == 0) {
+        return;
+    }
+    if (!phoneTrieInsert(&phonePrefixRoot, phone, length, kind, owner)) {
+        printf("警告: 内存不足，电话 %s 未加入号码索引\n", phone);
+        return;
+    }
+    if (!phoneTrieInsert(&phoneSuffixRoot, reversed, length, kind, owner)) {
+        phoneTrieRemove(&phonePrefixRoot, phone, length, kind, owner);
+        printf("警告: 内存不足，电话 %s 未加入号码索引\n", phone);
+    }
+}
+
+void phoneIndexRemove(const char* phone, int kind, void* owner) {
+    char reversed[PHONE_KEY_MAX];
+    int length = reversePhone(phone, reversed);
+    phoneTrieRemove(&phonePrefixRoot, phone, length, kind, owner);
+    phoneTrieRemove(&phoneSuffixRoot, reversed, length, kind, owner);
+}
+
+// 候床顺序: 病情分级小者优先, 同级按入队序号
+int waitBefore(const struct PatientRecord* a, const struct PatientRecord* b) {
+    if (a->acuity != b->acuity) {
+        return a->acuity < b->acuity;
+    }
+    return a->waitSeq < b->waitSeq;
+}
+
+void waitHeapSwap(struct WaitHeap* heap, int a, int b) {
+    struct PatientRecord* tmp = heap->items[a];
+    heap->items[a] = heap->items[b];
+    heap->items[b] = tmp;
+    heap->items[a]->waitPos = a;
+    heap->items[b]->waitPos = b;
+}
+
+void waitHeapSiftUp(struct WaitHeap* heap, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!waitBefore(heap->items[i], heap->items[parent])) {
+            break;
+        }
+        waitHeapSwap(heap, i, parent);
+        i = parent;
+    }
+}
+
+void waitHeapSiftDown(struct WaitHeap* heap, int i) {
+    while (1) {
+        int best = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < heap->count && waitBefore(heap->items[left], heap->items[best])) {
+            best = left;
+        }
+        if (right < heap->count && waitBefore(heap->items[right], heap->items[best])) {
+            best = right;
+        }
+        if (best == i) {
+            break;
+        }
+        waitHeapSwap(heap, i, best);
+        i = best;
+    }
+}
+
+// 候床需求所属的分类
+int waitClassIndex(const struct BedRequest* request) {
+    return freeClassIndex(bedTypeBitmapIndex(request->bedType),
+                          departmentBitmapIndex(request->department), request->needOxygen);
+}
+
+// 将未分配床位的病人加入候床队列, O(log n); 内存不足返回0
+// waitSince/waitSeq为0时使用当前时间和新的入队序号 (加载数据时沿用保存的值)
+int waitlistAdd(struct PatientRecord* record, const struct BedRequest* request, int acuity,
+                long long waitSince, long long waitSeq) {
+    struct WaitHeap* heap = &waitHeaps[waitClassIndex(request)];
+    if (heap->count == heap->capacity) {
+        int newCapacity = heap->capacity ? heap->capacity * 2 : 8;
+        struct PatientRecord** items = (struct PatientRecord**)realloc(heap->items, newCapacity * sizeof(struct PatientRecord*));
+        if (items == NULL) {
+            return 0;
+        }
+        heap->items = items;
+        heap->capacity = newCapacity;
+    }
+    record->request = *request;
+    record->request.needOxygen = request->needOxygen ? 1 : 0;
+    record->acuity = acuity;
+    record->waitSince = waitSince ? waitSince : (long long)time(NULL);
+    record->waitSeq = waitSeq ? waitSeq : waitSeqNext;
+    if (record->waitSeq >= waitSeqNext) {
+        waitSeqNext = record->waitSeq + 1;
+    }
+
+    int i = heap->count++;
+    heap->items[i] = record;
+    record->waitPos = i;
+    waitHeapSiftUp(heap, i);
+    waitCount++;
+    journalPatient(record);
+    return 1;
+}
+
+// 将病人移出候床队列 (不在队列中时无操作), O(log n)
+void waitlistRemove(struct PatientRecord* record) {
+    if (record->acuity == 0) {
+        return;
+    }
+    struct WaitHeap* heap = &waitHeaps[waitClassIndex(&record->request)];
+    int i = record->waitPos;
+    int last = --heap->count;
+    if (i != last) {
+        heap->items[i] = heap->items[last];
+        heap->items[i]->waitPos = i;
+        waitHeapSiftDown(heap, i);
+        waitHeapSiftUp(heap, i);
+    }
+    record->acuity = 0;
+    record->waitPos = -1;
+    waitCount--;
+}
+
+// 登记病人 (调用者需保证病人ID未登记), bed为病人当前所在床位或NULL; 内存不足返回NULL
+struct PatientRecord* patientRegistryAdd(const struct Patient* patient, struct Bed* bed) {
+    // 装载因子保持在0.5以下
+    if ((patientIndex.count + 1) * 2 > patientIndex.capacity) {
+        int newCapacity = patientIndex.capacity ? patientIndex.capacity * 2 : 64;
+        if (!patientIndexGrow(newCapacity)) {
+            return NULL;
+        }
+    }
+    struct PatientRecord* record = (struct PatientRecord*)slabAlloc(&patientPool);
+    if (record == NULL) {
+        return NULL;
+    }
+    record->patient = *patient;
+    record->bed = bed;
+    record->acuity = 0;
+    record->waitPos = -1;
+    textIndexAdd(record);
+    phoneIndexAdd(record->patient.phone, PhoneOwnerPatient, record);
+    patientIndex.slots[patientIndexProbe(patient->patientID)] = record;
+    patientIndex.count++;
+
+    record->prev = NULL;
+    record->next = patientHead;
+    if (patientHead != NULL) {
+        patientHead->prev = record;
+    }
+    patientHead = record;
+    if (bed == NULL) {
+        journalPatient(record);     // 在院病人的登记信息随床位记录
+    }
+    return record;
+}
+
+// 注销病人登记 (病人出院), 不修改其所在床位
+void patientRegistryRemove(struct PatientRecord* record) {
+    journalDelete(JournalPatientDelete, record->patient.patientID, 0);
+    waitlistRemove(record);
+    textIndexRemove(record);
+    phoneIndexRemove(record->patient.phone, PhoneOwnerPatient, record);
+    patientIndexRemove(record->patient.patientID);
+    if (record->prev != NULL) {
+        record->prev->next = record->next;
+    } else {
+        patientHead = record->next;
+    }
+    if (record->next != NULL) {
+        record->next->prev = record->prev;
+    }
+    slabFree(&patientPool, record);
+}
+
+// 将已登记且未分配床位的病人安置到空闲床位, 并移出候床队列
+void patientAssignBed(struct PatientRecord* record, struct Bed* bed) {
+    waitlistRemove(record);
+    bed->patient = record->patient;
+    bed->isOccupied = 1;
+    record->bed = bed;
+    bedStoreUpdate(bed);
+}
+
+// 释放床位上的病人占用; 若该病人已登记于此床位, 一并注销其登记并解除其医生关联. 返回归档的关联数量
+int dischargeBed(struct Bed* bed) {
+    int patientID = bed->patient.patientID;
+    struct PatientRecord* record = findPatientByID(patientID);
+    int archived = 0;
+    if (record != NULL && record->bed == bed) {
+        patientRegistryRemove(record);
+        archived = cascadePatientRelations(patientID);
+    }
+    bed->isOccupied = 0;
+    bed->patient.patientID = -1;
+    bedStoreUpdate(bed);
+    return archived;
+}
+
+// 打印候床时长
+void printWaitTime(long long waitSince) {
+    long long seconds = (long long)time(NULL) - waitSince;
+    if (seconds < 0) {
+        seconds = 0;
+    }
+    printf("%lld小时%lld分钟", seconds / 3600, seconds / 60 % 60);
+}
+
+// 床位空出时为其匹配最优先的候床病人并直接分配, O(log n)
+// 无供氧床位只能匹配不需要供氧的病人, 供氧床位取两类病人中更优先者; 返回被分配的病人或NULL
+struct PatientRecord* waitlistMatchBed(struct Bed* bed) {
+    if (bed->isOccupied || waitCount == 0) {
+        return NULL;
+    }
+    int typeIndex = bedTypeBitmapIndex(bed->bedType);
+    int departmentIndex = departmentBitmapIndex(bed->department);
+    struct WaitHeap* plain = &waitHeaps[freeClassIndex(typeIndex, departmentIndex, 0)];
+    struct WaitHeap* oxygen = &waitHeaps[freeClassIndex(typeIndex, departmentIndex, 1)];
+
+    struct PatientRecord* best = plain->count > 0 ? plain->items[0] : NULL;
+    if (bed->hasOxygen && oxygen->count > 0 && (best == NULL || waitBefore(oxygen->items[0], best))) {
+        best = oxygen->items[0];
+    }
+    if (best == NULL) {
+        return NULL;
+    }
+
+    long long waitSince = best->waitSince;
+    patientAssignBed(best, bed);
+    printf("\n? 候床病人 %s (ID: %d) 已自动分配到床位 %d，候床时长 ",
+           best->patient.name, best->patient.patientID, bed->ID);
+    printWaitTime(waitSince);
+    printf("\n");
+    return best;
+}
+
+// 为候床队列中所有能找到床位的病人分配床位, 按重症监护、急诊、普通的顺序处理; 返回分配人数
+int waitlistMatchAll() {
+    static const int typeOrder[BED_TYPE_COUNT] = {ICUBed, EmergencyBed, RegularBed};
+    int matched = 0;
+    for (int t = 0; t < BED_TYPE_COUNT && waitCount > 0; t++) {
+        for (int d = 1; d <= DEPARTMENT_COUNT; d++) {
+            // 同一床位类型和科室下, 不需要供氧(0)与需要供氧(1)的两个队列按优先顺序交替处理
+            struct WaitHeap* heaps[2];
+            int blocked[2] = {0, 0};
+            heaps[0] = &waitHeaps[freeClassIndex(typeOrder[t], d, 0)];
+            heaps[1] = &waitHeaps[freeClassIndex(typeOrder[t], d, 1)];
+            while (1) {
+                int k = -1;
+                for (int o = 0; o < 2; o++) {
+                    if (!blocked[o] && heaps[o]->count > 0 &&
+                        (k < 0 || waitBefore(heaps[o]->items[0], heaps[k]->items[0]))) {
+                        k = o;
+                    }
+                }
+                if (k < 0) {
+                    break;
+                }
+                struct PatientRecord* record = heaps[k]->items[0];
+                struct Bed* bed = allocateBed(&record->request);
+                if (bed == NULL) {
+                    blocked[k] = 1; // 同一队列中的其他病人同样没有床位
+                    continue;
+                }
+                patientAssignBed(record, bed);
+                matched++;
+            }
+        }
+    }
+    return matched;
+}
+
+// 打印分隔线
+void printSeparator() {
+    printf("\n");
+    printf("----------------------------------------------------------------\n");
+}
+
+// 打印操作标题
+void printOperationTitle(const char* title) {
+    printSeparator();
+    printf("【%s】\n", title);
+    printSeparator();
+}
+
+// 打印床位类型的辅助函数
+void printBedType(enum BedType type) {
+    switch(type) {
+        case RegularBed: printf("普通床位"); break;
+        case ICUBed: printf("重症监护"); break;
+        case EmergencyBed: printf("急诊床位"); break;
+        default: printf("未知类型");
+    }
+}
+
+// 打印科室的辅助函数
+void printDepartment(int department) {
+    switch(department) {
+        case 1: printf("内科"); break;
+        case 2: printf("外科"); break;
+        case 3: printf("儿科"); break;
+        case 4: printf("妇科"); break;
+        case 5: printf("其他"); break;
+        default: printf("未知");
+    }
+}
+
+// 打印床位基本信息的辅助函数
+void printBedBasicInfo(struct Bed* bed) {
+    printf("床位ID: %d | ", bed->ID);
+    printf("状态: %s | ", bed->isOccupied ? "已占用" : "空闲");
+    printf("供氧设备: %s | ", bed->hasOxygen ? "有" : "无");
+    
+    printf("类型: ");
+    printBedType(bed->bedType);
+    printf(" | ");
+    
+    printf("病房号: %d | ", bed->ward);
+    printf("科室: ");
+    printDepartment(bed->department);
+}
+
+// 打印病人信息的辅助函数
+void printPatientInfo(struct Patient* patient) {
+    printf("\n  病人信息: ID-%d | 姓名-%s | ", 
+        patient->patientID, patient->name);
+    printf("性别-%s | ", patient->gender ? "男" : "女");
+    printf("电话-%s | ", patient->phone);
+    printf("诊断-%s | ", patient->diagnosis);
+    printf("年龄-%d", patient->age);
+}
+
+// 打印病人登记记录, 包括当前所在床位
+void printPatientRecord(struct PatientRecord* record) {
+    printPatientInfo(&record->patient);
+    if (record->bed != NULL) {
+        printf("\n  床位ID: %d | 病房: %d | 科室: ", record->bed->ID, record->bed->ward);
+        printDepartment(record->bed->department);
+    } else {
+        printf("\n  尚未分配床位");
+    }
+    printf("\n");
+}
+
+// 显示可用床位的函数，用于registerPatient内部调用
+void listAvailableBedsLocal() {
+    int found = 0;
+    
+    printf("\n空闲床位列表：\n");
+    printf("----------------------------------------------------------------\n");
+    
+    int words = bedBitmapWords();
+    for (int w = 0; w < words; w++) {
+        unsigned long long freeBits = ~bedBitmaps.occupied[w];
+        if (w == words - 1 && (bedColumns.count & 63)) {
+            freeBits &= (1ULL << (bedColumns.count & 63)) - 1; // 屏蔽末尾未使用的槽位
+        }
+        while (freeBits) {
+            int i = w * 64 + lowestBit64(freeBits);
+            freeBits &= freeBits - 1;
+            printBedBasicInfo(bedColumns.record[i]);
+            printf("\n");
+            found = 1;
+        }
+    }
+    
+    printf("----------------------------------------------------------------\n");
+    if (!found) {
+        printf("没有空闲床位\n");
+    }
+}
+
+// 清空输入缓冲区的简化版本
+void flushStdin() {
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF);
+}
+
+// 存储锁: 主线程修改数据时持有 (读取输入期间不持有), 后台检查点复制数据和登记结果时持有
+struct Mutex storeMutex;
+int storeLocked;                    // 主线程当前是否持有存储锁
+
+// 修改数据前调用: 主线程取得存储锁 (已持有时无操作)
+void storeBegin() {
+    if (!storeLocked) {
+        mutexLock(&storeMutex);
+        storeLocked = 1;
+    }
+}
+
+// 修改完成后调用: 组提交本次操作的日志记录, 再释放存储锁 (未持有时无操作)
+void storeCommit() {
+    if (storeLocked) {
+        journalCommit();
+        storeLocked = 0;
+        mutexUnlock(&storeMutex);
+    }
+}
+
+// 等待用户按回车的简化版本
+void waitForEnter() {
+    storeCommit();      // 提示操作完成前先将本次修改写入操作日志, 等待输入期间不持有存储锁
+    printf("\n按回车键继续...");
+    getchar();
+}
+
+void printMenu() {
+    printf("\n");
+    printf("╔═════════════════════════════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║                                  医院床位管理系统                                                    ║\n");
+    printf("╠═════════════════════════════════════════════════════════════════════════════════════════════════════╣\n");
+    printf("║                                    【系统功能导航】                                                  ║\n");
+    printf("║                                                                                                     ║\n");
+    printf("║  【病人与床位管理】                                                                                  ║\n");
+    printf("║  1--登记新病人        (录入病人信息)     ║ 2--分配床位         (为病人分配床位)                    ║\n");
+    printf("║  3--病人出院          (释放占用床位)     ║ 4--添加新床位       (新增床位基础信息)                  ║\n");
+    printf("║  5--修改床位信息      (修改床位属性)     ║ 6--删除床位信息     (移除指定床位)                      ║\n");
+    printf("║                                                                                                     ║\n");
+    printf("║  【查询与筛选功能】                                                                                  ║\n");
+    printf("║  7--根据床位号查询    (查询单个床位)     ║ 8--所有床位信息     (显示所有床位)                      ║\n");
+    printf("║  9--查询空闲床位      (显示可用床位)     ║ 10--按床位类型筛选  (普通/重症/急诊)                    ║\n");
+    printf("║  11--按病房号筛选     (查看指定病房)     ║ 12--按科室筛选      (内科/外科等筛选)                   ║\n");
+    printf("║  13--按床位ID排序     (ID升序排列)      ║ 27--按ID范围查询    (如2000-2999)                        ║\n");
+    printf("║                                                                                                     ║\n");
+    printf("║  【医生管理功能】                                                                                    ║\n");
+    printf("║  14--添加医生记录     (新增医生信息)     ║ 15--修改医生信息    (修改医生资料)                      ║\n");
+    printf("║  16--删除医生记录     (移除指定医生)     ║ 17--查询医生信息    (查询单个医生)                      ║\n");
+    printf("║  18--列出所有医生     (显示所有医生)     ║ 19--分配病人给医生  (建立医生病人关联)                  ║\n");
+    printf("║  20--分配病房给医生   (医生负责病房)     ║ 21--查询医生的病人  (显示医生负责病人)                  ║\n");
+    printf("║  22--查询医生的病房   (显示医生负责病房)                                                           ║\n");
+    printf("║                                                                                                     ║\n");
+    printf("║  【统计与高级查询】                                                                                  ║\n");
+    printf("║  25--组合条件筛选     (多条件组合)      ║ 26--床位统计概览    (按类型/科室/病房)                   ║\n");
+    printf("║  28--查询病人信息     (按病人ID查询)    ║ 29--查看候床队列    (按病情与候床时长)                   ║\n");
+    printf("║  30--姓名/诊断搜索    (支持部分匹配)    ║ 31--按电话号码查询  (前缀或尾号)                         ║\n");
+    printf("║                                                                                                     ║\n");
+    printf("║  24--保存并退出系统   (保存当前所有数据并退出程序)                                                   ║\n");
+    printf("╚═════════════════════════════════════════════════════════════════════════════════════════════════════╝\n");
+    printf("请输入对应数字选择功能(1-13, 14-22, 24-31): ");
+}
+
+void addBed() {
+    printOperationTitle("添加新床位");
+    
+    struct Bed* newBed = (struct Bed*)slabAlloc(&bedPool);
+    if (newBed == NULL) {
+        printf("内存分配失败\n");
+        waitForEnter();
+        return;
+    }
+
+    printf("输入床位ID: ");
+    scanf("%d", &newBed->ID);
+    flushStdin(); // 清空输入缓冲区
+    
+    // 检查ID是否已存在
+    if (findBedByID(newBed->ID) != NULL) {
+        printf("错误: 床位ID %d 已存在，请使用其他ID\n", newBed->ID);
+        slabFree(&bedPool, newBed);
+        waitForEnter();
+        return;
+    }
+    
+    newBed->isOccupied = 0;
+    memset(&newBed->patient, 0, sizeof(newBed->patient)); // 空床的病人字段保存到文件时须为空字符串
+    newBed->patient.patientID = -1; // 初始化为未分配
+
+    printf("输入是否有供氧设备 (1有, 0无): ");
+    scanf("%d", &newBed->hasOxygen);
+    flushStdin(); // 清空输入缓冲区
+    
+    printf("输入床位类型 (0普通床位, 1重症监护床位, 2急诊床位): ");
+    scanf("%d", (int*)&newBed->bedType);
+    flushStdin(); // 清空输入缓冲区
+    
+    printf("输入病房号: ");
+    scanf("%d", &newBed->ward);
+    flushStdin(); // 清空输入缓冲区
+    
+    printf("输入科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+    scanf("%d", &newBed->department);
+    flushStdin(); // 清空输入缓冲区
+
+    storeBegin();
+    if (!bedStoreInsert(newBed)) {
+        printf("内存分配失败\n");
+        slabFree(&bedPool, newBed);
+        waitForEnter();
+        return;
+    }
+
+    printf("\n? 床位添加成功！新增床位信息如下：\n");
+    printSeparator();
+    printBedBasicInfo(newBed);
+    printf("\n");
+    printSeparator();
+    waitlistMatchBed(newBed);
+    waitForEnter(); // 暂停等待用户按回车
+}
+
+void searchBedByID() {
+    printOperationTitle("床位信息查询");
+    
+    int id;
+    printf("输入要查找的床位ID: ");
+    scanf("%d", &id);
+    flushStdin(); // 清空输入缓冲区
+
+    struct Bed* current = findBedByID(id);
+    if (current != NULL) {
+        printf("\n查询结果：\n");
+        printSeparator();
+        printBedBasicInfo(current);
+        if (current->isOccupied) {
+            printPatientInfo(&current->patient);
+        }
+        printf("\n");
+        printSeparator();
+        printf("\n按回车键返回主菜单..."); // 直接使用这种方式替代waitForEnter()
+        getchar();
+        return;
+    }
+
+    printf("\n? 未找到床位ID为%d的床位\n", id);
+    printf("\n按回车键返回主菜单..."); // 直接使用这种方式替代waitForEnter()
+    getchar();
+}
+
+void modifyBed() {
+    printOperationTitle("修改床位信息");
+    
+    int id;
+    printf("输入要修改的床位ID: ");
+    scanf("%d", &id);
+    flushStdin(); // 清空输入缓冲区
+
+    struct Bed* current = findBedByID(id);
+    if (current != NULL) {
+        printf("\n当前床位信息：\n");
+        printSeparator();
+        printBedBasicInfo(current);
+        printf("\n");
+        printSeparator();
+        
+        // 先读入副本, 输入完成后再持有存储锁修改床位
+        struct Bed input = *current;
+        printf("\n请输入新的信息：\n");
+        printf("输入新的是否有供氧设备 (1有, 0无): ");
+        scanf("%d", &input.hasOxygen);
+        flushStdin();
+        
+        printf("输入新的床位类型 (0普通床位, 1重症监护床位, 2急诊床位): ");
+        scanf("%d", (int*)&input.bedType);
+        flushStdin();
+        
+        printf("输入新的病房号: ");
+        scanf("%d", &input.ward);
+        flushStdin();
+        
+        printf("输入新的科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+        scanf("%d", &input.department);
+        flushStdin();
+        storeBegin();
+        current->hasOxygen = input.hasOxygen;
+        current->bedType = input.bedType;
+        current->ward = input.ward;
+        current->department = input.department;
+        bedStoreUpdate(current);
+        waitlistMatchBed(current); // 床位属性改变后可能满足候床病人的需求
+        
+        printf("\n? 床位信息修改成功！更新后信息如下：\n");
+        printSeparator();
+        printBedBasicInfo(current);
+        printf("\n");
+        printSeparator();
+        waitForEnter();
+        return;
+    }
+
+    printf("\n? 未找到床位ID为%d的床位\n", id);
+    waitForEnter();
+}
+
+void deleteBed() {
+    printOperationTitle("删除床位");
+    
+    int id;
+    printf("输入要删除的床位ID: ");
+    scanf("%d", &id);
+    flushStdin(); // 清空输入缓冲区
+
+    struct Bed* current = findBedByID(id);
+    if (current != NULL) {
+        // 检查床位是否被占用
+        if (current->isOccupied) {
+            printf("\n? 错误：床位ID %d 当前有病人占用，无法删除。请先办理病人出院。\n", id);
+            waitForEnter();
+            return;
+        }
+        
+        storeBegin();
+        bedStoreRemove(current);
+        slabFree(&bedPool, current);
+        printf("\n? 床位ID为%d的床位删除成功\n", id);
+        waitForEnter();
+        return;
+    }
+
+    printf("\n? 未找到床位ID为%d的床位\n", id);
+    waitForEnter();
+}
+
+void listAllBeds() {
+    printOperationTitle("所有床位信息");
+    
+    struct Bed* current = head;
+    if (current == NULL) {
+        printf("当前没有床位信息\n");
+        printf("\n按回车键返回主菜单...");
+        getchar();
+        return;
+    }
+    
+    printf("所有床位列表：\n");
+    printf("----------------------------------------------------------------\n");
+    
+    while (current != NULL) {
+        printBedBasicInfo(current);
+        
+        if (current->isOccupied) {
+            printPatientInfo(&current->patient);
+        }
+        printf("\n----------------------------------------------------------------\n");
+        current = current->next;
+    }
+    
+    printf("\n统计信息：总床位数: %d | 已占用: %d | 空闲: %d\n",
+           bedStats.all.total, bedStats.all.occupied, bedStats.all.total - bedStats.all.occupied);
+    printf("\n按回车键返回主菜单...");
+    getchar();
+}
+
+// 获取用户输入的病人信息
+// 读取病人ID以外的信息
+void getPatientDetails(struct Patient* patient) {
+    printf("输入病人姓名: ");
+    scanf("%s", patient->name);
+    flushStdin();
+    
+    printf("输入病人性别 (1男, 0女): ");
+    scanf("%d", &patient->gender);
+    flushStdin();
+    
+    printf("输入病人电话: ");
+    scanf("%s", patient->phone);
+    flushStdin();
+    
+    printf("输入诊断结果: ");
+    scanf(" %[^\n]", patient->diagnosis);
+    flushStdin();
+    
+    printf("输入病人年龄: ");
+    scanf("%d", &patient->age);
+    flushStdin();
+}
+
+void getPatientInfo(struct Patient* patient) {
+    printf("输入病人ID: ");
+    scanf("%d", &patient->patientID);
+    flushStdin();
+    
+    getPatientDetails(patient);
+}
+
+// 没有空闲床位时询问是否加入候床队列, 有满足条件的床位空出时自动分配
+void joinWaitlist(struct PatientRecord* record, const struct BedRequest* request) {
+    int choice;
+    printf("\n是否加入候床队列？(1是, 0否): ");
+    scanf("%d", &choice);
+    flushStdin();
+    if (choice != 1) {
+        return;
+    }
+    
+    int acuity;
+    printf("输入病情分级 (1-危重, 2-紧急, 3-较急, 4-普通, 5-非紧急): ");
+    scanf("%d", &acuity);
+    flushStdin();
+    if (acuity < 1 || acuity > ACUITY_LEVELS) {
+        printf("\n? 无效的病情分级\n");
+        return;
+    }
+    
+    storeBegin();
+    if (!waitlistAdd(record, request, acuity, 0, 0)) {
+        printf("内存分配失败\n");
+        return;
+    }
+    printf("\n? 病人 %s 已加入候床队列，当前共有 %d 名候床病人\n", record->patient.name, waitCount);
+}
+
+// 读取自动分配的约束条件, 输入无效时返回0
+int getBedRequest(struct BedRequest* request) {
+    printf("输入需要的床位类型 (0普通床位, 1重症监护床位, 2急诊床位): ");
+    scanf("%d", &request->bedType);
+    flushStdin();
+    
+    printf("输入需要的科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+    scanf("%d", &request->department);
+    flushStdin();
+    
+    printf("是否需要供氧设备 (1需要, 0不需要): ");
+    scanf("%d", &request->needOxygen);
+    flushStdin();
+    
+    printf("输入优先病房号 (0表示无偏好): ");
+    scanf("%d", &request->preferredWard);
+    flushStdin();
+    
+    if (request->bedType < 0 || request->bedType >= BED_TYPE_COUNT) {
+        printf("\n? 无效的床位类型\n");
+        return 0;
+    }
+    if (request->department < 1 || request->department > DEPARTMENT_COUNT) {
+        printf("\n? 无效的科室编号\n");
+        return 0;
+    }
+    return 1;
+}
+
+void registerPatient() {
+    printOperationTitle("病人登记");
+    
+    struct Patient newPatient;
+    printf("请输入病人基本信息:\n");
+    getPatientInfo(&newPatient);
+
+    if (findPatientByID(newPatient.patientID) != NULL) {
+        printf("\n? 错误：病人ID %d 已登记\n", newPatient.patientID);
+        waitForEnter();
+        return;
+    }
+    
+    // 保存到病人登记表, 未分配床位的病人同样会被保存
+    storeBegin();
+    struct PatientRecord* record = patientRegistryAdd(&newPatient, NULL);
+    if (record == NULL) {
+        printf("内存分配失败\n");
+        waitForEnter();
+        return;
+    }
+    storeCommit();      // 询问是否分配床位前先提交登记
+    printf("\n? 病人登记成功！\n");
+    
+    // 询问是否立即分配床位
+    int choice;
+    printf("\n是否现在为病人分配床位？(1手动选择, 2自动分配, 0否): ");
+    scanf("%d", &choice);
+    flushStdin();
+    
+    if (choice == 2) {
+        struct BedRequest request;
+        printf("\n请输入床位需求:\n");
+        if (!getBedRequest(&request)) {
+            waitForEnter();
+            return;
+        }
+        
+        struct Bed* bed = allocateBed(&request);
+        if (bed == NULL) {
+            printf("\n? 没有满足条件的空闲床位\n");
+            joinWaitlist(record, &request);
+            waitForEnter();
+            return;
+        }
+        
+        storeBegin();
+        patientAssignBed(record, bed);
+        printf("\n? 自动分配成功！病人 %s 已分配到床位 %d\n", newPatient.name, bed->ID);
+        printSeparator();
+        printBedBasicInfo(bed);
+        printf("\n");
+        printSeparator();
+        waitForEnter();
+    } else if (choice == 1) {
+        // 显示可用床位
+        listAvailableBedsLocal();
+        
+        // 检查是否有空闲床位
+        struct Bed* current;
+        
+        // listAvailableBedsLocal已经输出了没有空闲床位的消息, 与自动分配一样询问是否候床
+        if (countFreeBeds() == 0) {
+            struct BedRequest request;
+            printf("\n请输入床位需求 (加入候床队列后有满足条件的床位空出时自动分配):\n");
+            if (getBedRequest(&request)) {
+                joinWaitlist(record, &request);
+            }
+            waitForEnter();
+            return;
+        }
+        
+        // 选择床位
+        int bedID;
+        printf("\n输入要分配的床位ID: ");
+        scanf("%d", &bedID);
+        flushStdin();
+        
+        current = findBedByID(bedID);
+        if (current != NULL && !current->isOccupied) {
+            storeBegin();
+            patientAssignBed(record, current);
+            printf("\n? 床位分配成功！病人 %s 已分配到床位 %d\n", newPatient.name, bedID);
+            waitForEnter();
+            return;
+        } else if (current != NULL && current->isOccupied) {
+            printf("\n? 该床位已被占用，无法分配\n");
+            waitForEnter();
+            return;
+        }
+        
+        printf("\n? 未找到床位ID为%d的空闲床位\n", bedID);
+        waitForEnter();
+    } else {
+        waitForEnter();
+    }
+}
+
+void assignBed() {
+    printOperationTitle("床位分配");
+    
+    int bedID;
+    
+    printf("输入要分配的床位ID: ");
+    scanf("%d", &bedID);
+    flushStdin();
+
+    struct Bed* current = findBedByID(bedID);
+    if (current != NULL && !current->isOccupied) {
+        struct Patient patient;
+        printf("\n请输入病人ID: ");
+        scanf("%d", &patient.patientID);
+        flushStdin();
+        
+        // 已登记的病人直接使用登记信息, 否则录入并登记
+        struct PatientRecord* record = findPatientByID(patient.patientID);
+        if (record != NULL && record->bed != NULL) {
+            printf("\n? 该病人已在床位 %d，无法重复分配\n", record->bed->ID);
+            waitForEnter();
+            return;
+        }
+        if (record != NULL) {
+            printf("\n该病人已登记:");
+            printPatientInfo(&record->patient);
+            printf("\n");
+        } else {
+            printf("\n请输入病人信息:\n");
+            getPatientDetails(&patient);
+            storeBegin();
+            record = patientRegistryAdd(&patient, NULL);
+            if (record == NULL) {
+                printf("内存分配失败\n");
+                waitForEnter();
+                return;
+            }
+        }
+        storeBegin();
+        patientAssignBed(record, current);
+        printf("\n? 床位分配成功！病人 %s 已分配到床位 %d\n", current->patient.name, bedID);
+        waitForEnter();
+        return;
+    } else if (current != NULL && current->isOccupied) {
+        printf("\n? 该床位已被占用，无法分配。当前占用病人: %s\n", current->patient.name);
+        waitForEnter();
+        return;
+    }
+
+    printf("\n? 未找到床位ID为%d的空闲床位\n", bedID);
+    waitForEnter();
+}
+
+void dischargePatient() {
+    printOperationTitle("病人出院");
+    
+    int id;
+    printf("输入要办理出院的床位ID: ");
+    scanf("%d", &id);
+    flushStdin();
+
+    struct Bed* current = findBedByID(id);
+    if (current != NULL && current->isOccupied) {
+        printf("\n当前占用信息:\n");
+        printSeparator();
+        printf("床位ID: %d | 病人姓名: %s | 诊断: %s\n", 
+               current->ID, current->patient.name, current->patient.diagnosis);
+        printSeparator();
+               
+        printf("\n确认办理出院? (1确认, 0取消): ");
+        int confirm;
+        scanf("%d", &confirm);
+        flushStdin();
+        
+        if (confirm) {
+            storeBegin();
+            printf("\n? 病人 %s (ID: %d) 已办理出院，床位已释放\n", 
+                   current->patient.name, current->patient.patientID);
+            int relations = dischargeBed(current);
+            if (relations > 0) {
+                printf("已解除该病人的 %d 条医生关联并归档到 %s\n", relations, DOCTOR_PATIENT_ARCHIVE);
+            }
+            waitlistMatchBed(current);
+        } else {
+            printf("\n出院操作已取消\n");
+        }
+        waitForEnter();
+        return;
+    } else if (current != NULL && !current->isOccupied) {
+        printf("\n? 该床位本就空闲，无需办理出院\n");
+        waitForEnter();
+        return;
+    }
+
+    printf("\n? 未找到床位ID为%d的已占用床位\n", id);
+    waitForEnter();
+}
+
+// 合并床位文件各块解析出的床位: 查重后加入床位存储, 在院病人登记到病人表
+void loadBedsMerge(struct LoadTask* tasks, int taskCount) {
+    printf("正在加载床位数据...\n");
+    
+    struct LoadCursor cursor;
+    patientTableComplete = 0;
+    if (!loadCursorBegin(&cursor, tasks, taskCount, &bedPool)) {
+        return;
+    }
+    int recordCount = 0;
+    int registered = 1;         // 在院病人全部登记到病人表
+    struct Bed* newBed;
+    
+    // 记录数已知, 一次性为各索引分配空间
+    if (!bedStoreReserve(cursor.rows)) {
+        printf("警告: 内存不足，无法预先分配床位空间\n");
+    }
+    
+    while ((newBed = (struct Bed*)loadCursorNext(&cursor)) != NULL) {
+        // 检查床位ID是否重复
+        if (findBedByID(newBed->ID) != NULL) {
+            printf("警告: 床位ID %d 重复，跳过此行\n", newBed->ID);
+            slabFree(&bedPool, newBed);
+            continue;
+        }
+        
+        // 添加到床位存储
+        if (!bedStoreInsert(newBed)) {
+            printf("内存分配失败，已在第%lld行停止加载\n", cursor.lineNumber);
+            slabFree(&bedPool, newBed);
+            break;
+        }
+        recordCount++;
+        
+        // 在院病人加入病人登记表
+        if (newBed->isOccupied) {
+            if (findPatientByID(newBed->patient.patientID) != NULL) {
+                printf("警告: 病人ID %d 同时占用多个床位，床位 %d 未登记到病人表\n",
+                       newBed->patient.patientID, newBed->ID);
+                registered = 0;
+            } else if (patientRegistryAdd(&newBed->patient, newBed) == NULL) {
+                printf("警告: 内存不足，床位 %d 的病人未登记到病人表\n", newBed->ID);
+                registered = 0;
+            }
+        }
+    }
+
+    printf("床位信息加载成功！共加载 %d 条记录\n", recordCount);
+    printLoadStats(&cursor, recordCount);
+    patientTableComplete = registered && loadCursorComplete(&cursor, recordCount);
+}
+
+// 菜单选项6使用的函数，显示所有空闲床位
+void listAvailableBeds() {
+    printOperationTitle("查询空闲床位");
+    listAvailableBedsLocal(); // 复用已经写好的函数
+    printf("\n按回车键返回主菜单...");
+    getchar();
+}
+
+// 按床位ID排序: 直接按有序索引重建链表, 无需排序, O(n)
+void sortBedsByID() {
+    printOperationTitle("床位排序");
+    
+    if (head == NULL || head->next == NULL) {
+        printf("当前床位数量不足，无需排序\n");
+        waitForEnter();
+        return; // 0或1个节点不需要排序
+    }
+
+    // 按有序索引的底层链表顺序重新链接
+    storeBegin();
+    struct Bed* prev = NULL;
+    for (struct BedSkipNode* node = bedOrder.header->forward[0]; node != NULL; node = node->forward[0]) {
+        struct Bed* bed = node->bed;
+        bed->prev = prev;
+        if (prev == NULL) {
+            head = bed;
+        } else {
+            prev->next = bed;
+        }
+        prev = bed;
+    }
+    prev->next = NULL;
+    storeCommit();
+
+    printf("\n? 已按床位ID排序完成！排序结果如下：\n");
+    listAllBeds();
+}
+
+// 按床位ID范围查询, 结果按ID升序输出
+void listBedsByIDRange() {
+    printOperationTitle("按床位ID范围查询");
+    
+    int low, high;
+    printf("输入起始床位ID: ");
+    scanf("%d", &low);
+    flushStdin();
+    
+    printf("输入结束床位ID: ");
+    scanf("%d", &high);
+    flushStdin();
+    
+    int total = 0;
+    int occupied = 0;
+    
+    printf("\n床位ID在 %d-%d 之间的床位列表：\n", low, high);
+    printf("----------------------------------------------------------------\n");
+    
+    for (struct BedSkipNode* node = bedOrderSeek(low); node != NULL && node->bed->ID <= high; node = node->forward[0]) {
+        struct Bed* current = node->bed;
+        printBedBasicInfo(current);
+        
+        if (current->isOccupied) {
+            printPatientInfo(&current->patient);
+            occupied++;
+        }
+        printf("\n----------------------------------------------------------------\n");
+        total++;
+    }
+    
+    if (total == 0) {
+        printf("未找到床位ID在 %d-%d 之间的床位\n", low, high);
+    } else {
+        printf("\n统计信息：该范围总床位数: %d | 已占用: %d | 空闲: %d\n", total, occupied, total - occupied);
+    }
+    waitForEnter();
+}
+
+void filterBedsByType() {
+    printOperationTitle("按床位类型筛选");
+    
+    int bedType;
+    printf("输入要筛选的床位类型 (0普通床位, 1重症监护床位, 2急诊床位): ");
+    scanf("%d", &bedType);
+    flushStdin();
+
+    int found = 0;
+    int total = 0;
+    int occupied = 0;
+    
+    printf("\n床位类型为 ");
+    printBedType(bedType);
+    printf(" 的床位列表：\n");
+    printf("----------------------------------------------------------------\n");
+    
+    // 越界的类型值共用"其他"位图, 需逐条核对
+    int index = bedTypeBitmapIndex(bedType);
+    int exact = index != BED_TYPE_COUNT;
+    unsigned long long* members = bedBitmaps.byType[index];
+    int words = bedBitmapWords();
+    for (int w = 0; w < words; w++) {
+        unsigned long long bits = members[w];
+        while (bits) {
+            int i = w * 64 + lowestBit64(bits);
+            bits &= bits - 1;
+            struct Bed* current = bedColumns.record[i];
+            if (!exact && (int)current->bedType != bedType) {
+                continue;
+            }
+            printBedBasicInfo(current);
+            
+            if (bedColumns.isOccupied[i]) {
+                printPatientInfo(&current->patient);
+                occupied++;
+            }
+            printf("\n----------------------------------------------------------------\n");
+            found = 1;
+            total++;
+        }
+    }
+    if (exact) {
+        total = bedStats.byType[index].total;
+        occupied = bedStats.byType[index].occupied;
+    }
+    
+    if (!found) {
+        printf("未找到床位类型为%d的床位\n", bedType);
+    } else {
+        printf("\n统计信息：该类型总床位数: %d | 已占用: %d | 空闲: %d\n", total, occupied, total - occupied);
+    }
+    waitForEnter();
+}
+
+// 将床位副本按链表顺序保存为CSV (经临时文件原子替换), 返回保存的记录数, 失败返回-1
+int saveBedsToFile(const char* filename, const struct TableCopy* copy) {
+    char tempName[260];
+    FILE* file = atomicFileOpen(filename, tempName, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    // 写入CSV文件头
+    fprintf(file, "ID,isOccupied,hasOxygen,bedType,ward,department,patientID,name,gender,phone,diagnosis,age\n");
+    
+    const struct SnapshotBed* beds = (const struct SnapshotBed*)copy->records;
+    for (int i = 0; i < copy->count; i++) {
+        const struct SnapshotBed* current = &beds[copy->order[i]];
+        // 写入CSV格式的数据行
+        // 注意: 字符串字段使用双引号包围，避免逗号分隔符问题; 字段中的双引号写为两个双引号
+        char name[2 * sizeof(current->patient.name)], phone[2 * sizeof(current->patient.phone)];
+        char diagnosis[2 * sizeof(current->patient.diagnosis)];
+        fprintf(file, "%d,%d,%d,%d,%d,%d,%d,\"%s\",%d,\"%s\",\"%s\",%d\n",
+            current->ID,
+            current->isOccupied,
+            current->hasOxygen,
+            current->bedType,
+            current->ward,
+            current->department,
+            current->patient.patientID,
+            csvEscape(current->patient.name, name),
+            current->patient.gender,
+            csvEscape(current->patient.phone, phone),
+            csvEscape(current->patient.diagnosis, diagnosis),
+            current->patient.age);
+    }
+
+    return atomicFileCommit(file, tempName, filename, 0) ? copy->count : -1;
+}
+
+// 合并尚未分配床位的病人, 需在床位数据之后合并
+void loadPatientsMerge(struct LoadTask* tasks, int taskCount) {
+    printf("正在加载病人登记数据...\n");
+    
+    struct LoadCursor cursor;
+    if (!loadCursorBegin(&cursor, tasks, taskCount, NULL)) {
+        patientTableComplete = 0;
+        return;
+    }
+    int recordCount = 0;
+    struct PatientRow* row;
+    
+    if (!patientRegistryReserve(cursor.rows)) {
+        printf("警告: 内存不足，无法预先分配病人登记空间\n");
+    }
+    
+    while ((row = (struct PatientRow*)loadCursorNext(&cursor)) != NULL) {
+        // 检查病人ID是否已登记 (包括床位数据中的在院病人)
+        if (findPatientByID(row->patient.patientID) != NULL) {
+            printf("警告: 病人ID %d 重复，跳过此行\n", row->patient.patientID);
+            continue;
+        }
+        
+        struct PatientRecord* record = patientRegistryAdd(&row->patient, NULL);
+        if (record == NULL) {
+            printf("内存分配失败，已在第%lld行停止加载\n", cursor.lineNumber);
+            break;
+        }
+        recordCount++;
+        
+        // 恢复候床状态, 沿用原来的候床时间和入队序号
+        if (row->acuity != 0) {
+            if (row->acuity < 1 || row->acuity > ACUITY_LEVELS ||
+                row->request.bedType < 0 || row->request.bedType >= BED_TYPE_COUNT ||
+                row->request.department < 1 || row->request.department > DEPARTMENT_COUNT) {
+                printf("警告: 第%lld行候床信息无效，病人 %d 未加入候床队列\n", cursor.lineNumber, row->patient.patientID);
+            } else if (!waitlistAdd(record, &row->request, row->acuity, row->waitSince, row->waitSeq)) {
+                printf("警告: 内存不足，病人 %d 未加入候床队列\n", row->patient.patientID);
+            }
+        }
+    }
+
+    printf("病人登记信息加载成功！共加载 %d 条记录\n", recordCount);
+    printLoadStats(&cursor, recordCount);
+    patientTableComplete = patientTableComplete && loadCursorComplete(&cursor, recordCount);
+}
+
+// 保存尚未分配床位的病人 (副本中只有这些病人), 在院病人随床位数据一起保存
+int savePatientsToFile(const char* filename, const struct TableCopy* copy) {
+    char tempName[260];
+    FILE* file = atomicFileOpen(filename, tempName, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    // 写入CSV文件头
+    fprintf(file, "patientID,name,gender,phone,diagnosis,age,acuity,bedType,department,needOxygen,preferredWard,waitSince,waitSeq\n");
+    
+    const struct SnapshotPatient* patients = (const struct SnapshotPatient*)copy->records;
+    for (int i = 0; i < copy->count; i++) {
+        // 不在候床队列中的病人候床字段均为0 (复制时已处理)
+        const struct SnapshotPatient* current = &patients[i];
+        char name[2 * sizeof(current->patient.name)], phone[2 * sizeof(current->patient.phone)];
+        char diagnosis[2 * sizeof(current->patient.diagnosis)];
+        fprintf(file, "%d,\"%s\",%d,\"%s\",\"%s\",%d,%d,%d,%d,%d,%d,%lld,%lld\n",
+            current->patient.patientID,
+            csvEscape(current->patient.name, name),
+            current->patient.gender,
+            csvEscape(current->patient.phone, phone),
+            csvEscape(current->patient.diagnosis, diagnosis),
+            current->patient.age,
+            current->acuity,
+            current->request.bedType,
+            current->request.department,
+            current->request.needOxygen,
+            current->request.preferredWard,
+            current->waitSince,
+            current->waitSeq);
+    }
+
+    return atomicFileCommit(file, tempName, filename, 0) ? copy->count : -1;
+}
+
+// 根据病人ID查询登记信息
+void searchPatientByID() {
+    printOperationTitle("查询病人信息");
+    
+    int patientID;
+    printf("输入病人ID: ");
+    scanf("%d", &patientID);
+    flushStdin();
+    
+    struct PatientRecord* record = findPatientByID(patientID);
+    if (record == NULL) {
+        printf("\n? 未找到病人ID为%d的登记记录\n", patientID);
+        waitForEnter();
+        return;
+    }
+    
+    printf("\n病人信息：\n");
+    printSeparator();
+    printPatientRecord(record);
+    printSeparator();
+    waitForEnter();
+}
+
+// 在单个字段中查找匹配的病人, 追加到results; skipField>=0时跳过该字段同样匹配的病人 (避免重复)
+int searchTextField(int field, const char* query, int prefix, int skipField,
+                    struct PatientRecord** results, int count) {
+    struct PatientRecord* current = patientHead;
+    struct GramPosting* candidates = NULL;
+    if (!textIndex.incomplete) {
+        candidates = textIndexCandidates(field, query, prefix);
+        if (candidates == NULL) {
+            return count;
+        }
+    }
+    // 索引不完整时退化为顺序扫描全部病人
+    int n = candidates != NULL ? candidates->count : patientIndex.count;
+    for (int i = 0; i < n; i++) {
+        struct PatientRecord* record;
+        if (candidates != NULL) {
+            record = candidates->items[i];
+        } else {
+            record = current;
+            current = current->next;
+        }
+        const char* text = field == TEXT_FIELD_NAME ? record->patient.name : record->patient.diagnosis;
+        if (!textMatches(text, query, prefix)) {
+            continue;
+        }
+        if (skipField >= 0) {
+            const char* other = skipField == TEXT_FIELD_NAME ? record->patient.name : record->patient.diagnosis;
+            if (textMatches(other, query, prefix)) {
+                continue;
+            }
+        }
+        results[count++] = record;
+    }
+    return count;
+}
+
+int comparePatientID(const void* a, const void* b) {
+    int x = (*(const struct PatientRecord* const*)a)->patient.patientID;
+    int y = (*(const struct PatientRecord* const*)b)->patient.patientID;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+#define TEXT_SEARCH_DISPLAY_LIMIT 100   // 最多显示的结果数量
+
+// 按姓名或诊断搜索病人 (子串匹配, 以*结尾时为前缀匹配)
+void searchPatientsByText() {
+    printOperationTitle("按姓名/诊断搜索病人");
+    
+    int fieldChoice;
+    char query[TEXT_MAX_CHARS + 1];
+    printf("选择搜索范围 (1姓名, 2诊断, 0姓名和诊断): ");
+    scanf("%d", &fieldChoice);
+    flushStdin();
+    
+    printf("输入搜索内容 (以*结尾表示前缀匹配, 如 王*): ");
+    if (scanf(" %100[^\n]", query) != 1) {
+        query[0] = '\0';
+    }
+    flushStdin();
+    
+    size_t length = strlen(query);
+    int prefix = 0;
+    if (length > 0 && query[length - 1] == '*') {
+        query[--length] = '\0';
+        prefix = 1;
+    }
+    if (length == 0 || fieldChoice < 0 || fieldChoice > 2) {
+        printf("\n? 无效的搜索条件\n");
+        waitForEnter();
+        return;
+    }
+    
+    // 诊断字段跳过姓名已匹配的病人, 每个病人至多出现一次
+    struct PatientRecord** results = (struct PatientRecord**)malloc((patientIndex.count + 1) * sizeof(struct PatientRecord*));
+    if (results == NULL) {
+        printf("内存分配失败\n");
+        waitForEnter();
+        return;
+    }
+    
+    double startTime = nowSeconds();
+    int count = 0;
+    if (fieldChoice != 2) {
+        count = searchTextField(TEXT_FIELD_NAME, query, prefix, -1, results, count);
+    }
+    if (fieldChoice != 1) {
+        count = searchTextField(TEXT_FIELD_DIAGNOSIS, query, prefix,
+                                fieldChoice == 0 ? TEXT_FIELD_NAME : -1, results, count);
+    }
+    double elapsed = nowSeconds() - startTime;
+    qsort(results, count, sizeof(struct PatientRecord*), comparePatientID);
+    
+    printf("\n搜索结果：\n");
+    printf("----------------------------------------------------------------\n");
+    for (int i = 0; i < count && i < TEXT_SEARCH_DISPLAY_LIMIT; i++) {
+        struct PatientRecord* record = results[i];
+        printf("病人ID: %d | 姓名: %s | 诊断: %s | ",
+               record->patient.patientID, record->patient.name, record->patient.diagnosis);
+        if (record->bed != NULL) {
+            printf("床位ID: %d | 病房: %d\n", record->bed->ID, record->bed->ward);
+        } else {
+            printf("未分配床位\n");
+        }
+    }
+    printf("----------------------------------------------------------------\n");
+    if (count == 0) {
+        printf("没有匹配的病人\n");
+    } else {
+        printf("\n? 共找到 %d 名病人", count);
+        if (count > TEXT_SEARCH_DISPLAY_LIMIT) {
+            printf("，仅显示前 %d 名", TEXT_SEARCH_DISPLAY_LIMIT);
+        }
+        printf("\n");
+    }
+    printf("查询耗时 %.3f 毫秒%s\n", elapsed * 1000.0, textIndex.incomplete ? " (索引不完整, 已使用顺序扫描)" : "");
+    free(results);
+    waitForEnter();
+}
+
+// 按qsort的要求比较两个候床病人
+int compareWaiting(const void* a, const void* b) {
+    const struct PatientRecord* x = *(const struct PatientRecord* const*)a;
+    const struct PatientRecord* y = *(const struct PatientRecord* const*)b;
+    if (waitBefore(x, y)) {
+        return -1;
+    }
+    return waitBefore(y, x) ? 1 : 0;
+}
+
+// 显示候床队列: 重症监护优先, 同类型按病情分级和候床先后排列
+void listWaitlist() {
+    printOperationTitle("候床队列");
+    
+    if (waitCount == 0) {
+        printf("当前没有候床病人\n");
+        waitForEnter();
+        return;
+    }
+    
+    struct PatientRecord** list = (struct PatientRecord**)malloc(waitCount * sizeof(struct PatientRecord*));
+    if (list == NULL) {
+        printf("内存分配失败\n");
+        waitForEnter();
+        return;
+    }
+    
+    static const int typeOrder[BED_TYPE_COUNT] = {ICUBed, EmergencyBed, RegularBed};
+    for (int t = 0; t < BED_TYPE_COUNT; t++) {
+        int n = 0;
+        for (int d = 1; d <= DEPARTMENT_COUNT; d++) {
+            for (int o = 0; o < 2; o++) {
+                struct WaitHeap* heap = &waitHeaps[freeClassIndex(typeOrder[t], d, o)];
+                memcpy(list + n, heap->items, heap->count * sizeof(struct PatientRecord*));
+                n += heap->count;
+            }
+        }
+        if (n == 0) {
+            continue;
+        }
+        qsort(list, n, sizeof(struct PatientRecord*), compareWaiting);
+        
+        printf("\n");
+        printBedType((enum BedType)typeOrder[t]);
+        printf(" (%d人):\n", n);
+        printf("----------------------------------------------------------------\n");
+        for (int i = 0; i < n; i++) {
+            struct PatientRecord* record = list[i];
+            printf("%d. 病人ID: %d | 姓名: %s | 病情分级: %d | 科室: ",
+                   i + 1, record->patient.patientID, record->patient.name, record->acuity);
+            printDepartment(record->request.department);
+            printf(" | %s | 候床时长: ", record->request.needOxygen ? "需供氧" : "无需供氧");
+            printWaitTime(record->waitSince);
+            printf("\n");
+        }
+    }
+    printf("----------------------------------------------------------------\n");
+    printf("\n? 共有 %d 名候床病人\n", waitCount);
+    free(list);
+    waitForEnter();
+}
+
+void filterBedsByWard() {
+    printOperationTitle("按病房号筛选");
+    
+    int ward;
+    printf("输入要筛选的病房号: ");
+    scanf("%d", &ward);
+    flushStdin();
+
+    int found = 0;
+    int total = 0;
+    int occupied = 0;
+    
+    printf("\n病房号为 %d 的床位列表：\n", ward);
+    printf("----------------------------------------------------------------\n");
+    
+    struct WardIndex* wardBits = findWardIndex(ward);
+    int words = bedBitmapWords();
+    for (int w = 0; wardBits != NULL && w < words; w++) {
+        unsigned long long bits = wardBits->members[w];
+        while (bits) {
+            int i = w * 64 + lowestBit64(bits);
+            bits &= bits - 1;
+            struct Bed* current = bedColumns.record[i];
+            printBedBasicInfo(current);
+            
+            if (bedColumns.isOccupied[i]) {
+                printPatientInfo(&current->patient);
+            }
+            printf("\n----------------------------------------------------------------\n");
+            found = 1;
+        }
+    }
+    if (found) {
+        total = wardBits->counter.total;
+        occupied = wardBits->counter.occupied;
+    }
+    
+    if (!found) {
+        printf("未找到病房号为%d的床位\n", ward);
+    } else {
+        printf("\n统计信息：该病房总床位数: %d | 已占用: %d | 空闲: %d\n", total, occupied, total - occupied);
+    }
+    waitForEnter();
+}
+
+void filterBedsByDepartment() {
+    printOperationTitle("按科室筛选");
+    
+    int department;
+    printf("输入要筛选的科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+    scanf("%d", &department);
+    flushStdin();
+
+    int found = 0;
+    int total = 0;
+    int occupied = 0;
+    
+    printf("\n科室 ");
+    printDepartment(department);
+    printf(" 的床位列表：\n");
+    printf("----------------------------------------------------------------\n");
+    
+    // 越界的科室编号共用"其他"位图, 需逐条核对
+    int index = departmentBitmapIndex(department);
+    int exact = index != 0;
+    unsigned long long* members = bedBitmaps.byDepartment[index];
+    int words = bedBitmapWords();
+    for (int w = 0; w < words; w++) {
+        unsigned long long bits = members[w];
+        while (bits) {
+            int i = w * 64 + lowestBit64(bits);
+            bits &= bits - 1;
+            struct Bed* current = bedColumns.record[i];
+            if (!exact && current->department != department) {
+                continue;
+            }
+            printBedBasicInfo(current);
+            
+            if (bedColumns.isOccupied[i]) {
+                printPatientInfo(&current->patient);
+                occupied++;
+            }
+            printf("\n----------------------------------------------------------------\n");
+            found = 1;
+            total++;
+        }
+    }
+    if (exact) {
+        total = bedStats.byDepartment[index].total;
+        occupied = bedStats.byDepartment[index].occupied;
+    }
+    
+    if (!found) {
+        printf("未找到科室编号为%d的床位\n", department);
+    } else {
+        printf("\n统计信息：该科室总床位数: %d | 已占用: %d | 空闲: %d\n", total, occupied, total - occupied);
+    }
+    waitForEnter();
+}
+
+// 组合条件筛选: 床位类型、病房号、科室和供氧设备可任意组合
+void filterBedsCombined() {
+    printOperationTitle("组合条件筛选");
+    
+    struct BedFilter filter;
+    printf("以下条件输入-1表示不限\n");
+    printf("输入床位类型 (0普通床位, 1重症监护床位, 2急诊床位): ");
+    scanf("%d", &filter.bedType);
+    flushStdin();
+    
+    printf("输入病房号: ");
+    scanf("%d", &filter.ward);
+    flushStdin();
+    
+    printf("输入科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+    scanf("%d", &filter.department);
+    flushStdin();
+    
+    printf("输入供氧设备 (1有供氧, 0无供氧, -1不限): ");
+    scanf("%d", &filter.hasOxygen);
+    flushStdin();
+    
+    int words = bitsetWords(bedColumns.count);
+    unsigned long long* matches = (unsigned long long*)malloc((words ? words : 1) * sizeof(unsigned long long));
+    unsigned long long* scratch = (unsigned long long*)malloc((words ? words : 1) * sizeof(unsigned long long));
+    if (matches == NULL || scratch == NULL) {
+        printf("内存分配失败\n");
+        free(matches);
+        free(scratch);
+        waitForEnter();
+        return;
+    }
+    bedFilterScan(&filter, matches, scratch);
+    
+    int total = 0;
+    int occupied = 0;
+    
+    printf("\n符合条件的床位列表：\n");
+    printf("----------------------------------------------------------------\n");
+    
+    for (int w = 0; w < words; w++) {
+        unsigned long long bits = matches[w];
+        while (bits) {
+            int i = w * 64 + lowestBit64(bits);
+            bits &= bits - 1;
+            struct Bed* current = bedColumns.record[i];
+            if ((filter.bedType != -1 && (int)current->bedType != filter.bedType) ||
+                (filter.department != -1 && current->department != filter.department)) {
+                continue; // 列编码为BED_CODE_OTHER的越界取值
+            }
+            printBedBasicInfo(current);
+            
+            if (bedColumns.isOccupied[i]) {
+                printPatientInfo(&current->patient);
+                occupied++;
+            }
+            printf("\n----------------------------------------------------------------\n");
+            total++;
+        }
+    }
+    free(matches);
+    free(scratch);
+    
+    if (total == 0) {
+        printf("未找到符合条件的床位\n");
+    } else {
+        printf("\n统计信息：符合条件的床位数: %d | 已占用: %d | 空闲: %d\n", total, occupied, total - occupied);
+    }
+    waitForEnter();
+}
+
+// 打印一行床位计数
+void printBedCounter(const struct BedCounter* counter) {
+    printf("总床位数: %d | 已占用: %d | 空闲: %d\n",
+           counter->total, counter->occupied, counter->total - counter->occupied);
+}
+
+// 床位统计概览: 直接读取增量维护的计数器, 不遍历床位
+void showBedSummary() {
+    printOperationTitle("床位统计概览");
+    
+    printf("全院: ");
+    printBedCounter(&bedStats.all);
+    printSeparator();
+    
+    printf("按床位类型：\n");
+    for (int t = 0; t < BED_TYPE_COUNT; t++) {
+        printf("  ");
+        printBedType((enum BedType)t);
+        printf(": ");
+        printBedCounter(&bedStats.byType[t]);
+    }
+    if (bedStats.byType[BED_TYPE_COUNT].total > 0) {
+        printf("  未知类型: ");
+        printBedCounter(&bedStats.byType[BED_TYPE_COUNT]);
+    }
+    
+    printf("\n按科室：\n");
+    for (int d = 1; d <= DEPARTMENT_COUNT; d++) {
+        printf("  ");
+        printDepartment(d);
+        printf(": ");
+        printBedCounter(&bedStats.byDepartment[d]);
+    }
+    if (bedStats.byDepartment[0].total > 0) {
+        printf("  未知: ");
+        printBedCounter(&bedStats.byDepartment[0]);
+    }
+    
+    printf("\n按病房：\n");
+    for (int w = 0; w < bedBitmaps.wardCount; w++) {
+        if (bedBitmaps.wards[w].counter.total > 0) {
+            printf("  病房 %d: ", bedBitmaps.wards[w].ward);
+            printBedCounter(&bedBitmaps.wards[w].counter);
+        }
+    }
+    waitForEnter();
+}
+
+// 释放内存
+void cleanupMemory() {
+    // 床位、医生及关联记录均来自内存池, 整块释放即可, 无需逐个节点释放
+    slabRelease(&bedPool);
+    slabRelease(&doctorPool);
+    slabRelease(&doctorPatientPool);
+    slabRelease(&doctorWardPool);
+    slabRelease(&patientPool);
+    slabRelease(&phoneNodePool);
+    slabRelease(&phoneEntryPool);
+    memset(&phonePrefixRoot, 0, sizeof(phonePrefixRoot));
+    memset(&phoneSuffixRoot, 0, sizeof(phoneSuffixRoot));
+    head = NULL;
+    doctorHead = NULL;
+    doctorPatientHead = NULL;
+    doctorWardHead = NULL;
+    patientHead = NULL;
+    
+    // 床位、病人及医生索引内存清理
+    free(bedIndex.slots);
+    bedIndex.slots = NULL;
+    bedIndex.capacity = 0;
+    bedIndex.count = 0;
+    free(patientIndex.slots);
+    patientIndex.slots = NULL;
+    patientIndex.capacity = 0;
+    patientIndex.count = 0;
+    free(doctorIndex.slots);
+    doctorIndex.slots = NULL;
+    doctorIndex.capacity = 0;
+    doctorIndex.count = 0;
+    adjacencyFree(&doctorPatientByDoctor);
+    adjacencyFree(&doctorPatientByPatient);
+    adjacencyFree(&doctorWardByDoctor);
+    adjacencyFree(&doctorWardByWard);
+    relationSetFree(&doctorPatientPairs);
+    relationSetFree(&doctorWardPairs);
+    
+    textIndexFree();
+    
+    // 医生负载堆内存清理
+    for (int d = 0; d <= DEPARTMENT_COUNT; d++) {
+        free(doctorLoadHeaps[d].items);
+    }
+    memset(doctorLoadHeaps, 0, sizeof(doctorLoadHeaps));
+    
+    // 候床队列内存清理
+    for (int c = 0; c < FREE_CLASS_COUNT; c++) {
+        free(waitHeaps[c].items);
+    }
+    memset(waitHeaps, 0, sizeof(waitHeaps));
+    waitCount = 0;
+    
+    // 床位列存储内存清理
+    free(bedColumns.ID);
+    free(bedColumns.isOccupied);
+    free(bedColumns.hasOxygen);
+    free(bedColumns.bedType);
+    free(bedColumns.ward);
+    free(bedColumns.department);
+    free(bedColumns.record);
+    memset(&bedColumns, 0, sizeof(bedColumns));
+    bedBitmapsFree();
+    bedOrderFree();
+    
+    // 床位检查点脏页标记清理
+    free(bedFile.dirtyPages);
+    memset(&bedFile, 0, sizeof(bedFile));
+}
+
+// 打印医生职称的辅助函数
+void printQualification(int qualification) {
+    switch(qualification) {
+        case 1: printf("住院医师"); break;
+        case 2: printf("主治医师"); break;
+        case 3: printf("副主任医师"); break;
+        case 4: printf("主任医师"); break;
+        default: printf("未知职称");
+    }
+}
+
+// 打印医生信息的辅助函数
+void printDoctorBasicInfo(struct Doctor* doctor) {
+    printf("医生ID: %d | ", doctor->doctorID);
+    printf("姓名: %s | ", doctor->name);
+    printf("性别: %s | ", doctor->gender ? "男" : "女");
+    printf("电话: %s | ", doctor->phone);
+    
+    printf("科室: ");
+    printDepartment(doctor->department);
+    printf(" | ");
+    
+    printf("专业: %s | ", doctor->specialization);
+    
+    printf("职称: ");
+    printQualification(doctor->qualification);
+    printf(" | ");
+    
+    printf("办公室: %s", doctor->officeLocation);
+}
+
+// 获取用户输入的医生信息
+void getDoctorInfo(struct Doctor* doctor) {
+    printf("输入医生ID: ");
+    scanf("%d", &doctor->doctorID);
+    flushStdin();
+    
+    printf("输入医生姓名: ");
+    scanf("%s", doctor->name);
+    flushStdin();
+    
+    printf("输入医生性别 (1男, 0女): ");
+    scanf("%d", &doctor->gender);
+    flushStdin();
+    
+    printf("输入医生电话: ");
+    scanf("%s", doctor->phone);
+    flushStdin();
+    
+    printf("输入所属科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+    scanf("%d", &doctor->department);
+    flushStdin();
+    
+    printf("输入专业/专长: ");
+    scanf(" %[^\n]", doctor->specialization);
+    flushStdin();
+    
+    printf("输入职称 (1-住院医师, 2-主治医师, 3-副主任医师, 4-主任医师): ");
+    scanf("%d", &doctor->qualification);
+    flushStdin();
+    
+    printf("输入办公室位置: ");
+    scanf(" %[^\n]", doctor->officeLocation);
+    flushStdin();
+}
+
+// 合并医生数据
+void loadDoctorsMerge(struct LoadTask* tasks, int taskCount) {
+    printf("正在加载医生数据...\n");
+    
+    struct LoadCursor cursor;
+    if (!loadCursorBegin(&cursor, tasks, taskCount, &doctorPool)) {
+        return;
+    }
+    int recordCount = 0;
+    struct Doctor* newDoctor;
+    
+    if (!doctorStoreReserve(cursor.rows)) {
+        printf("警告: 内存不足，无法预先分配医生空间\n");
+    }
+    
+    while ((newDoctor = (struct Doctor*)loadCursorNext(&cursor)) != NULL) {
+        // 检查医生ID是否重复
+        if (findDoctorByID(newDoctor->doctorID) != NULL) {
+            printf("警告: 医生ID %d 重复，跳过此行\n", newDoctor->doctorID);
+            slabFree(&doctorPool, newDoctor);
+            continue;
+        }
+        
+        // 加入索引和链表
+        if (!doctorStoreInsert(newDoctor)) {
+            printf("内存分配失败，已在第%lld行停止加载\n", cursor.lineNumber);
+            slabFree(&doctorPool, newDoctor);
+            break;
+        }
+        phoneIndexAdd(newDoctor->phone, PhoneOwnerDoctor, newDoctor);
+        recordCount++;
+    }
+
+    printf("医生信息加载成功！共加载 %d 条记录\n", recordCount);
+    printLoadStats(&cursor, recordCount);
+}
+
+// 保存医生数据到CSV文件
+int saveDoctorsToFile(const char* filename, const struct TableCopy* copy) {
+    char tempName[260];
+    FILE* file = atomicFileOpen(filename, tempName, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    // 写入CSV文件头
+    fprintf(file, "doctorID,name,gender,phone,department,specialization,qualification,officeLocation\n");
+    
+    const struct SnapshotDoctor* doctors = (const struct SnapshotDoctor*)copy->records;
+    for (int i = 0; i < copy->count; i++) {
+        // 写入CSV格式的数据行
+        const struct SnapshotDoctor* current = &doctors[i];
+        char name[2 * sizeof(current->name)], phone[2 * sizeof(current->phone)];
+        char specialization[2 * sizeof(current->specialization)], officeLocation[2 * sizeof(current->officeLocation)];
+        fprintf(file, "%d,\"%s\",%d,\"%s\",%d,\"%s\",%d,\"%s\"\n",
+            current->doctorID,
+            csvEscape(current->name, name),
+            current->gender,
+            csvEscape(current->phone, phone),
+            current->department,
+            csvEscape(current->specialization, specialization),
+            current->qualification,
+            csvEscape(current->officeLocation, officeLocation));
+    }
+
+    return atomicFileCommit(file, tempName, filename, 0) ? copy->count : -1;
+}
+
+// 合并医生-病人关联数据, 需在医生数据之后合并 (病人已不存在的关联在重放日志后由archiveOrphanRelations归档)
+void loadDoctorPatientMerge(struct LoadTask* tasks, int taskCount) {
+    printf("正在加载医生-病人关联数据...\n");
+    
+    struct LoadCursor cursor;
+    if (!loadCursorBegin(&cursor, tasks, taskCount, &doctorPatientPool)) {
+        return;
+    }
+    int recordCount = 0;
+    relationSetReserve(&doctorPatientPairs, cursor.rows);
+    struct DoctorPatientRelation* newRelation;
+    
+    while ((newRelation = (struct DoctorPatientRelation*)loadCursorNext(&cursor)) != NULL) {
+        // 同一医生与病人的关联只保留第一条
+        if (findDoctorPatientRelation(newRelation->doctorID, newRelation->patientID) != NULL) {
+            printf("警告: 医生ID %d 与病人ID %d 的关联重复，跳过此行\n", newRelation->doctorID, newRelation->patientID);
+            slabFree(&doctorPatientPool, newRelation);
+            continue;
+        }
+        
+        // 加入链表、查重集合和邻接索引
+        if (!doctorPatientLink(newRelation)) {
+            printf("内存分配失败，已在第%lld行停止加载\n", cursor.lineNumber);
+            slabFree(&doctorPatientPool, newRelation);
+            break;
+        }
+        recordCount++;
+    }
+
+    // 逐条插入后的邻接索引含有搬迁空洞, 压缩为紧凑布局
+    adjacencyCompact(&doctorPatientByDoctor);
+    adjacencyCompact(&doctorPatientByPatient);
+    printf("医生-病人关联数据加载成功！共加载 %d 条记录\n", recordCount);
+    printLoadStats(&cursor, recordCount);
+}
+
+// 保存医生-病人关联数据到CSV文件
+int saveDoctorPatientToFile(const char* filename, const struct TableCopy* copy) {
+    char tempName[260];
+    FILE* file = atomicFileOpen(filename, tempName, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    // 写入CSV文件头
+    fprintf(file, "doctorID,patientID,notes,startDate\n");
+    
+    const struct SnapshotDoctorPatient* relations = (const struct SnapshotDoctorPatient*)copy->records;
+    for (int i = 0; i < copy->count; i++) {
+        // 写入CSV格式的数据行
+        const struct SnapshotDoctorPatient* current = &relations[i];
+        char notes[2 * sizeof(current->notes)], startDate[2 * sizeof(current->startDate)];
+        fprintf(file, "%d,%d,\"%s\",\"%s\"\n",
+            current->doctorID,
+            current->patientID,
+            csvEscape(current->notes, notes),
+            csvEscape(current->startDate, startDate));
+    }
+
+    return atomicFileCommit(file, tempName, filename, 0) ? copy->count : -1;
+}
+
+// 合并医生-病房关联数据
+void loadDoctorWardMerge(struct LoadTask* tasks, int taskCount) {
+    printf("正在加载医生-病房关联数据...\n");
+    
+    struct LoadCursor cursor;
+    if (!loadCursorBegin(&cursor, tasks, taskCount, &doctorWardPool)) {
+        return;
+    }
+    int recordCount = 0;
+    relationSetReserve(&doctorWardPairs, cursor.rows);
+    struct DoctorWardRelation* newRelation;
+    
+    while ((newRelation = (struct DoctorWardRelation*)loadCursorNext(&cursor)) != NULL) {
+        // 同一医生与病房的关联只保留第一条
+        if (findDoctorWardRelation(newRelation->doctorID, newRelation->wardNumber) != NULL) {
+            printf("警告: 医生ID %d 与病房号 %d 的关联重复，跳过此行\n", newRelation->doctorID, newRelation->wardNumber);
+            slabFree(&doctorWardPool, newRelation);
+            continue;
+        }
+        
+        // 加入链表、查重集合和邻接索引
+        if (!doctorWardLink(newRelation)) {
+            printf("内存分配失败，已在第%lld行停止加载\n", cursor.lineNumber);
+            slabFree(&doctorWardPool, newRelation);
+            break;
+        }
+        recordCount++;
+    }
+
+    // 逐条插入后的邻接索引含有搬迁空洞, 压缩为紧凑布局
+    adjacencyCompact(&doctorWardByDoctor);
+    adjacencyCompact(&doctorWardByWard);
+    printf("医生-病房关联数据加载成功！共加载 %d 条记录\n", recordCount);
+    printLoadStats(&cursor, recordCount);
+}
+
+// 保存医生-病房关联数据到CSV文件
+int saveDoctorWardToFile(const char* filename, const struct TableCopy* copy) {
+    char tempName[260];
+    FILE* file = atomicFileOpen(filename, tempName, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    // 写入CSV文件头
+    fprintf(file, "doctorID,wardNumber,isHeadDoctor,scheduleInfo\n");
+    
+    const struct SnapshotDoctorWard* relations = (const struct SnapshotDoctorWard*)copy->records;
+    for (int i = 0; i < copy->count; i++) {
+        // 写入CSV格式的数据行
+        const struct SnapshotDoctorWard* current = &relations[i];
+        char scheduleInfo[2 * sizeof(current->scheduleInfo)];
+        fprintf(file, "%d,%d,%d,\"%s\"\n",
+            current->doctorID,
+            current->wardNumber,
+            current->isHeadDoctor,
+            csvEscape(current->scheduleInfo, scheduleInfo));
+    }
+
+    return atomicFileCommit(file, tempName, filename, 0) ? copy->count : -1;
+}
+
+// 二进制快照: 文件头记录各数据块的记录大小、数量、偏移和校验和, 数据块为定长记录数组.
+// 启动时映射整个文件并直接复制记录, 无需逐行解析CSV; CSV仍作为导入导出格式
+#define SNAPSHOT_FILE "hospital.snap"
+#define SNAPSHOT_MAGIC "HBMSNAP"    // 含结尾的'\0'共8字节
+#define SNAPSHOT_VERSION 2         // 版本2起床位保存在单独的床位检查点文件中
+
+enum SnapshotBlockType {
+    SnapshotPatients,           // 未分配床位的登记病人 (在院病人随床位保存)
+    SnapshotDoctors,
+    SnapshotDoctorPatient,
+    SnapshotDoctorWard,
+    SNAPSHOT_BLOCK_COUNT
+};
+
+struct SnapshotBlock {
+    unsigned int recordSize;    // 单条记录字节数, 与当前程序不一致时拒绝加载
+    unsigned int count;         // 记录数量
+    unsigned long long offset;  // 数据块在文件中的偏移 (8字节对齐)
+    unsigned int checksum;      // 数据块的校验和 (逐条记录累加)
+    unsigned int reserved;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    unsigned int version;
+    unsigned int blockCount;
+    long long savedAt;          // 保存时间 (秒)
+    long long bedCheckpoint;    // 配套的床位检查点文件的检查点编号
+    struct SnapshotBlock blocks[SNAPSHOT_BLOCK_COUNT];
+    unsigned int headerChecksum; // 文件头中此字段之前部分的校验和
+    unsigned int reserved;
+};
+
+// 内存对象与定长记录之间的转换 (快照和操作日志共用); 记录先清零, 保证未使用的字节确定
+void snapshotFromBed(struct SnapshotBed* record, const struct Bed* bed) {
+    memset(record, 0, sizeof(*record));
+    record->ID = bed->ID;
+    record->isOccupied = bed->isOccupied;
+    record->hasOxygen = bed->hasOxygen;
+    record->bedType = (int)bed->bedType;
+    record->ward = bed->ward;
+    record->department = bed->department;
+    record->patient = bed->patient;
+}
+
+void bedFromSnapshot(struct Bed* bed, const struct SnapshotBed* record) {
+    bed->ID = record->ID;
+    bed->isOccupied = record->isOccupied;
+    bed->hasOxygen = record->hasOxygen;
+    bed->bedType = (enum BedType)record->bedType;
+    bed->ward = record->ward;
+    bed->department = record->department;
+    bed->patient = record->patient;
+}
+
+// 未分配床位的登记病人 (不在候床队列中时候床字段均为0)
+void snapshotFromPatient(struct SnapshotPatient* record, const struct PatientRecord* patient) {
+    memset(record, 0, sizeof(*record));
+    record->patient = patient->patient;
+    record->acuity = patient->acuity;
+    if (patient->acuity != 0) {
+        record->request = patient->request;
+        record->waitSince = patient->waitSince;
+        record->waitSeq = patient->waitSeq;
+    }
+}
+
+void snapshotFromDoctor(struct SnapshotDoctor* record, const struct Doctor* doctor) {
+    memset(record, 0, sizeof(*record));
+    record->doctorID = doctor->doctorID;
+    memcpy(record->name, doctor->name, sizeof(record->name));
+    record->gender = doctor->gender;
+    memcpy(record->phone, doctor->phone, sizeof(record->phone));
+    record->department = doctor->department;
+    memcpy(record->specialization, doctor->specialization, sizeof(record->specialization));
+    record->qualification = doctor->qualification;
+    memcpy(record->officeLocation, doctor->officeLocation, sizeof(record->officeLocation));
+}
+
+void doctorFromSnapshot(struct Doctor* doctor, const struct SnapshotDoctor* record) {
+    doctor->doctorID = record->doctorID;
+    memcpy(doctor->name, record->name, sizeof(doctor->name));
+    doctor->gender = record->gender;
+    memcpy(doctor->phone, record->phone, sizeof(doctor->phone));
+    doctor->department = record->department;
+    memcpy(doctor->specialization, record->specialization, sizeof(doctor->specialization));
+    doctor->qualification = record->qualification;
+    memcpy(doctor->officeLocation, record->officeLocation, sizeof(doctor->officeLocation));
+}
+
+void snapshotFromDoctorPatient(struct SnapshotDoctorPatient* record, const struct DoctorPatientRelation* relation) {
+    memset(record, 0, sizeof(*record));
+    record->doctorID = relation->doctorID;
+    record->patientID = relation->patientID;
+    memcpy(record->notes, relation->notes, sizeof(record->notes));
+    memcpy(record->startDate, relation->startDate, sizeof(record->startDate));
+}
+
+void doctorPatientFromSnapshot(struct DoctorPatientRelation* relation, const struct SnapshotDoctorPatient* record) {
+    relation->doctorID = record->doctorID;
+    relation->patientID = record->patientID;
+    memcpy(relation->notes, record->notes, sizeof(relation->notes));
+    memcpy(relation->startDate, record->startDate, sizeof(relation->startDate));
+}
+
+void snapshotFromDoctorWard(struct SnapshotDoctorWard* record, const struct DoctorWardRelation* relation) {
+    memset(record, 0, sizeof(*record));
+    record->doctorID = relation->doctorID;
+    record->wardNumber = relation->wardNumber;
+    record->isHeadDoctor = relation->isHeadDoctor;
+    memcpy(record->scheduleInfo, relation->scheduleInfo, sizeof(record->scheduleInfo));
+}
+
+void doctorWardFromSnapshot(struct DoctorWardRelation* relation, const struct SnapshotDoctorWard* record) {
+    relation->doctorID = record->doctorID;
+    relation->wardNumber = record->wardNumber;
+    relation->isHeadDoctor = record->isHeadDoctor;
+    memcpy(relation->scheduleInfo, record->scheduleInfo, sizeof(relation->scheduleInfo));
+}
+
+// 映射到内存的文件 (只读映射, 或实时模式下床位检查点文件的读写映射)
+struct MappedFile {
+    const unsigned char* data;  // 读写映射时经mappedFileWritable取得可写指针
+    long long size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    FILE* stream;
+#endif
+};
+
+// 映射整个文件, 失败或文件为空时返回0. 只读映射用于顺序加载; 读写映射 (writable非0) 的修改直接写入文件,
+// 与同时只读打开该文件的其他进程共享系统页缓存
+int mappedFileOpen(struct MappedFile* mapped, const char* filename, int writable) {
+    mapped->data = NULL;
+    mapped->size = 0;
+#ifdef _WIN32
+    mapped->file = CreateFileA(filename, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, NULL,
+                               OPEN_EXISTING, writable ? FILE_ATTRIBUTE_NORMAL : FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                               NULL);
+    if (mapped->file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mapped->file, &size) || size.QuadPart == 0) {
+        CloseHandle(mapped->file);
+        return 0;
+    }
+    mapped->mapping = CreateFileMappingA(mapped->file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+    if (mapped->mapping == NULL) {
+        CloseHandle(mapped->file);
+        return 0;
+    }
+    mapped->data = (const unsigned char*)MapViewOfFile(mapped->mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    if (mapped->data == NULL) {
+        CloseHandle(mapped->mapping);
+        CloseHandle(mapped->file);
+        return 0;
+    }
+    mapped->size = size.QuadPart;
+#else
+    mapped->stream = fopen(filename, writable ? "r+b" : "rb");
+    if (mapped->stream == NULL) {
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fileno(mapped->stream), &info) != 0 || info.st_size == 0) {
+        fclose(mapped->stream);
+        return 0;
+    }
+    void* data = mmap(NULL, (size_t)info.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                      writable ? MAP_SHARED : MAP_PRIVATE, fileno(mapped->stream), 0);
+    if (data == MAP_FAILED) {
+        fclose(mapped->stream);
+        return 0;
+    }
+    if (!writable) {
+        posix_madvise(data, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);  // 只读映射按顺序读取, 提示内核预读
+    }
+    mapped->data = (const unsigned char*)data;
+    mapped->size = (long long)info.st_size;
+#endif
+    return 1;
+}
+
+void mappedFileClose(struct MappedFile* mapped) {
+    if (mapped->data == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapped->data);
+    CloseHandle(mapped->mapping);
+    CloseHandle(mapped->file);
+#else
+    munmap((void*)mapped->data, (size_t)mapped->size);
+    fclose(mapped->stream);
+#endif
+    mapped->data = NULL;
+}
+
+// 读写映射的可写地址
+unsigned char* mappedFileWritable(struct MappedFile* mapped) {
+    return (unsigned char*)mapped->data;
+}
+
+// 将读写映射中[offset, offset + length)范围内修改过的内容写入磁盘, 成功返回1
+int mappedFileSync(struct MappedFile* mapped, long long offset, long long length) {
+#ifdef _WIN32
+    return FlushViewOfFile(mapped->data + offset, (SIZE_T)length) && FlushFileBuffers(mapped->file);
+#else
+    long long pageSize = sysconf(_SC_PAGESIZE);
+    long long start = offset / pageSize * pageSize;     // msync要求起始地址按页对齐
+    return msync((void*)(mapped->data + start), (size_t)(offset + length - start), MS_SYNC) == 0;
+#endif
+}
+
+// 文件最后修改时间 (秒), 文件不存在时返回-1
+long long fileModifiedTime(const char* filename) {
+#ifdef _WIN32
+    struct __stat64 info;
+    if (_stat64(filename, &info) != 0) {
+        return -1;
+    }
+#else
+    struct stat info;
+    if (stat(filename, &info) != 0) {
+        return -1;
+    }
+#endif
+    return (long long)info.st_mtime;
+}
+
+// FNV-1a式校验和, 每次处理8字节, 尾部逐字节; 按记录分段累加 (首段传入CHECKSUM_INIT)
+unsigned int checksumUpdate(unsigned int hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    unsigned long long h = hash;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        unsigned long long word;
+        memcpy(&word, bytes + i, sizeof(word));
+        h = (h ^ word) * 0x100000001b3ULL;
+    }
+    for (; i < size; i++) {
+        h = (h ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return (unsigned int)(h ^ (h >> 32));
+}
+
+#define CHECKSUM_INIT 2166136261u
+
+// 快照写入状态: 逐条写入记录并累加当前数据块的校验和
+struct SnapshotWriter {
+    FILE* file;
+    long long position;
+    struct SnapshotHeader header;
+    int block;
+    int failed;
+};
+
+void snapshotBeginBlock(struct SnapshotWriter* writer, int block, unsigned int recordSize) {
+    static const char padding[8] = {0};
+    int pad = (int)((8 - writer->position % 8) % 8);
+    if (pad > 0 && fwrite(padding, 1, pad, writer->file) != (size_t)pad) {
+        writer->failed = 1;
+    }
+    writer->position += pad;
+    writer->block = block;
+    writer->header.blocks[block].recordSize = recordSize;
+    writer->header.blocks[block].count = 0;
+    writer->header.blocks[block].offset = (unsigned long long)writer->position;
+    writer->header.blocks[block].checksum = CHECKSUM_INIT;
+}
+
+void snapshotWriteRecord(struct SnapshotWriter* writer, const void* record) {
+    struct SnapshotBlock* block = &writer->header.blocks[writer->block];
+    if (fwrite(record, block->recordSize, 1, writer->file) != 1) {
+        writer->failed = 1;
+    }
+    block->checksum = checksumUpdate(block->checksum, record, block->recordSize);
+    block->count++;
+    writer->position += block->recordSize;
+}
+
+// 床位检查点文件: 文件头, 各页校验和, 按8字节对齐的记录区 (capacity个槽位, 超出床位数的槽位为全零).
+// 记录按床位在列存储中的槽位存放, 因此修改床位只影响其所在页, 保存时原地重写这些页即可
+#define BED_FILE "hospital.beds"
+#define BED_FILE_MAGIC "HBMBEDS"    // 含结尾的'\0'共8字节
+#define BED_FILE_VERSION 1
+
+// 实时模式: 运行期间读写映射床位检查点文件, 床位修改在每次提交时原地写入 (编译时定义为1开启)
+#ifndef LIVE_BED_FILE
+#define LIVE_BED_FILE 0
+#endif
+
+struct BedFileHeader {
+    char magic[8];
+    unsigned int version;
+    unsigned int recordSize;
+    int count;                  // 床位数 (槽位0 ~ count-1)
+    int capacity;               // 记录槽位数, 为BED_PAGE_RECORDS的整数倍
+    long long checkpoint;       // 检查点编号, 快照文件头中保存与之配套的编号
+    unsigned int headerChecksum; // 文件头中此字段之前部分的校验和
+    unsigned int live;          // 实时模式打开期间为1, 内容可能比快照新; 正常退出或检查点整体写入时清零
+};
+
+long long bedFileDataOffset(int capacity) {
+    long long offset = sizeof(struct BedFileHeader) + (long long)(capacity / BED_PAGE_RECORDS) * sizeof(unsigned int);
+    return (offset + 7) / 8 * 8;
+}
+
+// 从床位副本取出第page页的定长记录 (超出床位数的槽位清零), 返回该页的校验和
+unsigned int bedFileFillPage(struct SnapshotBed* records, int page, const struct TableCopy* beds) {
+    const struct SnapshotBed* source = (const struct SnapshotBed*)beds->records;
+    int first = page * BED_PAGE_RECORDS;
+    int used = beds->count - first;
+    used = used < 0 ? 0 : used > BED_PAGE_RECORDS ? BED_PAGE_RECORDS : used;
+    memcpy(records, source + first, sizeof(struct SnapshotBed) * used);
+    memset(records + used, 0, sizeof(struct SnapshotBed) * (BED_PAGE_RECORDS - used));
+    return checksumUpdate(CHECKSUM_INIT, records, sizeof(struct SnapshotBed) * BED_PAGE_RECORDS);
+}
+
+void bedFileFinishHeader(struct BedFileHeader* header, int count, int capacity, long long checkpoint) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, BED_FILE_MAGIC, sizeof(header->magic));
+    header->version = BED_FILE_VERSION;
+    header->recordSize = sizeof(struct SnapshotBed);
+    header->count = count;
+    header->capacity = capacity;
+    header->checkpoint = checkpoint;
+    header->headerChecksum = checksumUpdate(CHECKSUM_INIT, header, offsetof(struct BedFileHeader, headerChecksum));
+}
+
+// 整体重写床位检查点文件 (经临时文件替换), 预留四分之一的空槽位供新增床位原地写入; 成功返回容量, 失败返回0
+int bedFileWriteAll(const char* filename, long long checkpoint, const struct TableCopy* beds) {
+    int pages = beds->count / BED_PAGE_RECORDS + 1;
+    pages += pages / 4;
+    int capacity = pages * BED_PAGE_RECORDS;
+    long long dataOffset = bedFileDataOffset(capacity);
+
+    char tempName[260];
+    FILE* file = atomicFileOpen(filename, tempName, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    unsigned int* checksums = (unsigned int*)calloc(pages, sizeof(unsigned int));
+    struct SnapshotBed* records = (struct SnapshotBed*)malloc(sizeof(struct SnapshotBed) * BED_PAGE_RECORDS);
+    int failed = checksums == NULL || records == NULL;
+
+    // 文件头和校验和表先占位, 写完各页后回填
+    if (!failed && fileSeek(file, dataOffset) != 0) {
+        failed = 1;
+    }
+    for (int page = 0; page < pages && !failed; page++) {
+        checksums[page] = bedFileFillPage(records, page, beds);
+        if (fwrite(records, sizeof(struct SnapshotBed), BED_PAGE_RECORDS, file) != BED_PAGE_RECORDS) {
+            failed = 1;
+        }
+    }
+    struct BedFileHeader header;
+    bedFileFinishHeader(&header, beds->count, capacity, checkpoint);
+    if (!failed && (fileSeek(file, 0) != 0 || fwrite(&header, sizeof(header), 1, file) != 1 ||
+                    fwrite(checksums, sizeof(unsigned int), pages, file) != (size_t)pages)) {
+        failed = 1;
+    }
+    free(checksums);
+    free(records);
+    return atomicFileCommit(file, tempName, filename, failed) ? capacity : 0;
+}
+
+// 原地重写复制时标记为已修改的页, 各页落盘后再更新文件头和校验和表;
+// 成功返回重写的页数; 文件与复制时记录的检查点不一致时不做修改并返回-1, 写入失败返回-2
+int bedFileWriteDirty(const char* filename, long long checkpoint, const struct Checkpoint* cp) {
+    const struct TableCopy* beds = &cp->tables[TableBeds];
+    FILE* file = fopen(filename, "r+b");
+    if (file == NULL) {
+        return -1;
+    }
+    struct BedFileHeader header;
+    int pages = cp->bedCapacity / BED_PAGE_RECORDS;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, BED_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != BED_FILE_VERSION ||
+        header.recordSize != sizeof(struct SnapshotBed) || header.capacity != cp->bedCapacity ||
+        header.checkpoint != cp->bedCheckpoint) {
+        fclose(file);
+        return -1;
+    }
+    unsigned int* checksums = (unsigned int*)malloc(pages * sizeof(unsigned int));
+    struct SnapshotBed* records = (struct SnapshotBed*)malloc(sizeof(struct SnapshotBed) * BED_PAGE_RECORDS);
+    if (checksums == NULL || records == NULL ||
+        fread(checksums, sizeof(unsigned int), pages, file) != (size_t)pages) {
+        free(checksums);
+        free(records);
+        fclose(file);
+        return -1;
+    }
+
+    long long dataOffset = bedFileDataOffset(cp->bedCapacity);
+    long long pageBytes = (long long)sizeof(struct SnapshotBed) * BED_PAGE_RECORDS;
+    int written = 0;
+    int failed = 0;
+    for (int w = 0; w < cp->dirtyWords && !failed; w++) {
+        unsigned long long bits = cp->dirtyPages[w];
+        while (bits != 0 && !failed) {
+            int page = w * 64 + lowestBit64(bits);
+            bits &= bits - 1;
+            if (page >= pages) {
+                continue;   // 超出容量的槽位已不存在 (调用者保证床位数不超过容量)
+            }
+            checksums[page] = bedFileFillPage(records, page, beds);
+            if (fileSeek(file, dataOffset + page * pageBytes) != 0 ||
+                fwrite(records, sizeof(struct SnapshotBed), BED_PAGE_RECORDS, file) != BED_PAGE_RECORDS) {
+                failed = 1;
+            }
+            written++;
+        }
+    }
+    // 先确保各页落盘, 再让文件头指向新的检查点
+    if (!failed && (fflush(file) != 0 || fileSync(file) != 0)) {
+        failed = 1;
+    }
+    bedFileFinishHeader(&header, beds->count, cp->bedCapacity, checkpoint);
+    if (!failed && (fileSeek(file, 0) != 0 || fwrite(&header, sizeof(header), 1, file) != 1 ||
+                    fwrite(checksums, sizeof(unsigned int), pages, file) != (size_t)pages ||
+                    fflush(file) != 0 || fileSync(file) != 0)) {
+        failed = 1;
+    }
+    if (fclose(file) != 0) {
+        failed = 1;
+    }
+    free(checksums);
+    free(records);
+    if (failed) {
+        printf("写入床位检查点文件 %s 失败\n", filename);
+        return -2;
+    }
+    return written;
+}
+
+// 从检查点的床位副本保存床位检查点文件: 与文件同步且容量足够时只重写被修改过的页, 否则整体重写;
+// 成功时记下新的检查点编号和容量并返回1 (由checkpointFinish登记到bedFile)
+int saveBedFile(const char* filename, struct Checkpoint* cp) {
+    const struct TableCopy* beds = &cp->tables[TableBeds];
+    long long checkpoint = (long long)time(NULL);
+    if (checkpoint <= cp->bedCheckpoint) {
+        checkpoint = cp->bedCheckpoint + 1;
+    }
+    int written = -1;
+    if (cp->bedCheckpoint != 0 && beds->count <= cp->bedCapacity) {
+        written = bedFileWriteDirty(filename, checkpoint, cp);
+    }
+    if (written >= 0) {
+        cp->newBedCapacity = cp->bedCapacity;
+        if (!cp->quiet) {
+            printf("\n? 床位检查点保存成功！重写 %d / %d 页\n", written, cp->bedCapacity / BED_PAGE_RECORDS);
+        }
+    } else {
+        // 文件与内存不同步、容量不足或原地写入中途失败 (文件可能已部分修改) 时整体重写
+        cp->newBedCapacity = bedFileWriteAll(filename, checkpoint, beds);
+        if (cp->newBedCapacity == 0) {
+            return 0;
+        }
+        if (!cp->quiet) {
+            printf("\n? 床位检查点保存成功！共 %d 条记录\n", beds->count);
+        }
+    }
+    cp->newBedCheckpoint = checkpoint;
+    cp->bedSaved = 1;
+    return 1;
+}
+
+// 校验床位检查点文件, 其检查点编号须与快照中记录的一致; 有效时返回记录区起始地址, 否则返回NULL
+const struct SnapshotBed* bedFileValidate(const struct MappedFile* mapped, long long checkpoint) {
+    if (mapped->size < (long long)sizeof(struct BedFileHeader)) {
+        printf("床位检查点文件不完整\n");
+        return NULL;
+    }
+    const struct BedFileHeader* header = (const struct BedFileHeader*)mapped->data;
+    if (memcmp(header->magic, BED_FILE_MAGIC, sizeof(header->magic)) != 0 || header->version != BED_FILE_VERSION ||
+        header->recordSize != sizeof(struct SnapshotBed) ||
+        checksumUpdate(CHECKSUM_INIT, header, offsetof(struct BedFileHeader, headerChecksum)) != header->headerChecksum) {
+        printf("床位检查点文件格式或版本不匹配\n");
+        return NULL;
+    }
+    if (header->live != 0) {
+        printf("床位检查点文件上次未正常关闭 (实时模式下可能比快照新)\n");
+        return NULL;
+    }
+    if (header->checkpoint != checkpoint) {
+        printf("床位检查点文件与快照不属于同一次保存\n");
+        return NULL;
+    }
+    if (header->capacity <= 0 || header->capacity % BED_PAGE_RECORDS != 0 ||
+        header->count < 0 || header->count > header->capacity ||
+        bedFileDataOffset(header->capacity) + (long long)header->capacity * (long long)sizeof(struct SnapshotBed) > mapped->size) {
+        printf("床位检查点文件的记录范围无效\n");
+        return NULL;
+    }
+    const unsigned int* checksums = (const unsigned int*)(mapped->data + sizeof(struct BedFileHeader));
+    const struct SnapshotBed* records = (const struct SnapshotBed*)(mapped->data + bedFileDataOffset(header->capacity));
+    int usedPages = (header->count + BED_PAGE_RECORDS - 1) / BED_PAGE_RECORDS;
+    for (int page = 0; page < usedPages; page++) {
+        if (checksumUpdate(CHECKSUM_INIT, records + (size_t)page * BED_PAGE_RECORDS,
+                           sizeof(struct SnapshotBed) * BED_PAGE_RECORDS) != checksums[page]) {
+            printf("床位检查点文件第 %d 页校验失败\n", page);
+            return NULL;
+        }
+    }
+    return records;
+}
+
+// 实时模式: 床位检查点文件在运行期间保持读写映射, 每次操作日志落盘后将被修改过的记录原地写入并同步到磁盘,
+// 文件始终反映最近一次提交的床位状态, 检查点和退出时无需再写入. 文件内容可能比快照新,
+// 因此文件头的live标记只在正常退出时清除, 上次未正常退出时启动改为从CSV文件加载并重放操作日志
+struct MappedFile bedFileLive;      // data为NULL表示未使用实时模式
+
+// 设置文件头中的实时标记并同步到磁盘, 成功返回1
+int bedFileLiveMark(unsigned int live) {
+    struct BedFileHeader* header = (struct BedFileHeader*)mappedFileWritable(&bedFileLive);
+    header->live = live;
+    return mappedFileSync(&bedFileLive, 0, sizeof(*header));
+}
+
+// 以新的检查点编号整体重写床位检查点文件 (预留空槽位), 成功返回1
+int bedFileLiveRewrite() {
+    struct TableCopy beds = {NULL, NULL, bedColumns.count};
+    beds.records = malloc((size_t)(bedColumns.count + 1) * sizeof(struct SnapshotBed));
+    if (beds.records == NULL) {
+        printf("警告: 内存不足，无法重写床位检查点文件\n");
+        return 0;
+    }
+    for (int i = 0; i < bedColumns.count; i++) {
+        snapshotFromBed((struct SnapshotBed*)beds.records + i, bedColumns.record[i]);
+    }
+    long long checkpoint = (long long)time(NULL);
+    if (checkpoint <= bedFile.checkpoint) {
+        checkpoint = bedFile.checkpoint + 1;
+    }
+    int capacity = bedFileWriteAll(BED_FILE, checkpoint, &beds);
+    free(beds.records);
+    if (capacity == 0) {
+        bedFile.checkpoint = 0;
+        return 0;
+    }
+    bedFile.checkpoint = checkpoint;
+    bedFile.capacity = capacity;
+    bedFile.pagesLost = 0;
+    if (bedFile.dirtyPages != NULL) {
+        memset(bedFile.dirtyPages, 0, bedFile.dirtyWords * sizeof(unsigned long long));
+    }
+    return 1;
+}
+
+void bedFileLiveCommit();
+
+// 打开实时模式 (调用者保证操作日志可用): 文件与内存不同步或容量不足时先整体重写, 再读写映射并写入
+// 加载和重放期间被修改的页. 成功返回1
+int bedFileLiveOpen() {
+    if (bedFile.checkpoint == 0 || bedFile.pagesLost || bedColumns.count > bedFile.capacity) {
+        if (!bedFileLiveRewrite()) {
+            return 0;
+        }
+    }
+    if (!mappedFileOpen(&bedFileLive, BED_FILE, 1)) {
+        printf("无法以读写方式映射床位检查点文件 %s\n", BED_FILE);
+        return 0;
+    }
+    const struct BedFileHeader* header = (const struct BedFileHeader*)bedFileLive.data;
+    if (bedFileLive.size < bedFileDataOffset(bedFile.capacity) + (long long)bedFile.capacity * (long long)sizeof(struct SnapshotBed) ||
+        header->checkpoint != bedFile.checkpoint || header->capacity != bedFile.capacity || !bedFileLiveMark(1)) {
+        printf("床位检查点文件 %s 与内存不一致\n", BED_FILE);
+        mappedFileClose(&bedFileLive);
+        return 0;
+    }
+    bedFileLiveCommit();
+    return bedFileLive.data != NULL;
+}
+
+// 退出实时模式. clean非0表示检查点已完整保存 (文件与快照一致), 清除文件头中的实时标记
+void bedFileLiveClose(int clean) {
+    if (bedFileLive.data == NULL) {
+        return;
+    }
+    if (clean) {
+        bedFileLiveMark(0);
+    }
+    mappedFileClose(&bedFileLive);
+}
+
+// 将被修改过的床位记录原地写入映射 (只改写内容变化的记录, 未变化的系统页不会写盘), 先同步各页,
+// 再同步文件头和校验和表. 在操作日志落盘后调用; 容量不足时整体重写并重新映射,
+// 同步失败时退出实时模式, 由之后的检查点整体重写床位检查点文件
+void bedFileLiveCommit() {
+    if (bedColumns.count > bedFile.capacity || bedFile.pagesLost) {
+        mappedFileClose(&bedFileLive);
+        if (!bedFileLiveRewrite() || !bedFileLiveOpen()) {
+            printf("警告: 无法重写床位检查点文件，退出实时模式\n");
+        }
+        return;
+    }
+    int pages = bedFile.capacity / BED_PAGE_RECORDS;
+    unsigned char* data = mappedFileWritable(&bedFileLive);
+    struct BedFileHeader* header = (struct BedFileHeader*)data;
+    unsigned int* checksums = (unsigned int*)(data + sizeof(struct BedFileHeader));
+    long long dataOffset = bedFileDataOffset(bedFile.capacity);
+    struct SnapshotBed* records = (struct SnapshotBed*)(data + dataOffset);
+    int first = -1, last = -1;
+    for (int w = 0; w < bedFile.dirtyWords; w++) {
+        unsigned long long bits = bedFile.dirtyPages[w];
+        bedFile.dirtyPages[w] = 0;
+        while (bits != 0) {
+            int page = w * 64 + lowestBit64(bits);
+            bits &= bits - 1;
+            if (page >= pages) {
+                continue;
+            }
+            struct SnapshotBed* pageRecords = records + (size_t)page * BED_PAGE_RECORDS;
+            for (int i = 0; i < BED_PAGE_RECORDS; i++) {
+                int slot = page * BED_PAGE_RECORDS + i;
+                struct SnapshotBed record;
+                if (slot < bedColumns.count) {
+                    snapshotFromBed(&record, bedColumns.record[slot]);
+                } else {
+                    memset(&record, 0, sizeof(record));
+                }
+                if (memcmp(&pageRecords[i], &record, sizeof(record)) != 0) {
+                    pageRecords[i] = record;
+                }
+            }
+            checksums[page] = checksumUpdate(CHECKSUM_INIT, pageRecords, sizeof(struct SnapshotBed) * BED_PAGE_RECORDS);
+            if (first < 0) {
+                first = page;
+            }
+            last = page;
+        }
+    }
+    if (first < 0) {
+        return;
+    }
+    long long pageBytes = (long long)sizeof(struct SnapshotBed) * BED_PAGE_RECORDS;
+    header->count = bedColumns.count;
+    header->headerChecksum = checksumUpdate(CHECKSUM_INIT, header, offsetof(struct BedFileHeader, headerChecksum));
+    if (!mappedFileSync(&bedFileLive, dataOffset + first * pageBytes, (last - first + 1) * pageBytes) ||
+        !mappedFileSync(&bedFileLive, 0, dataOffset)) {
+        printf("警告: 同步床位检查点文件失败，退出实时模式\n");
+        mappedFileClose(&bedFileLive);
+        bedFile.checkpoint = 0;
+    }
+}
+
+// 从检查点副本保存二进制快照: 先写入临时文件, 完整写入后再替换原快照, 成功返回1
+int saveSnapshot(const char* filename, const struct Checkpoint* cp) {
+    char tempName[260];
+    struct SnapshotWriter writer;
+    memset(&writer, 0, sizeof(writer));
+    writer.file = atomicFileOpen(filename, tempName, "wb");
+    if (writer.file == NULL) {
+        return 0;
+    }
+
+    // 先占位写入文件头, 数据块写完后回填
+    if (fwrite(&writer.header, sizeof(writer.header), 1, writer.file) != 1) {
+        writer.failed = 1;
+    }
+    writer.position = sizeof(writer.header);
+
+    // 副本按链表顺序排列; 加载时倒序插入链表头部, 从而保持原有顺序
+    static const int blockTables[SNAPSHOT_BLOCK_COUNT] = {TablePatients, TableDoctors, TableDoctorPatient, TableDoctorWard};
+    static const unsigned int recordSizes[SNAPSHOT_BLOCK_COUNT] = {
+        sizeof(struct SnapshotPatient), sizeof(struct SnapshotDoctor),
+        sizeof(struct SnapshotDoctorPatient), sizeof(struct SnapshotDoctorWard)
+    };
+    for (int block = 0; block < SNAPSHOT_BLOCK_COUNT; block++) {
+        const struct TableCopy* copy = &cp->tables[blockTables[block]];
+        snapshotBeginBlock(&writer, block, recordSizes[block]);
+        for (int i = 0; i < copy->count; i++) {
+            snapshotWriteRecord(&writer, (const char*)copy->records + (size_t)i * recordSizes[block]);
+        }
+    }
+
+    // 回填文件头
+    memcpy(writer.header.magic, SNAPSHOT_MAGIC, sizeof(writer.header.magic));
+    writer.header.version = SNAPSHOT_VERSION;
+    writer.header.blockCount = SNAPSHOT_BLOCK_COUNT;
+    writer.header.savedAt = (long long)time(NULL);
+    writer.header.bedCheckpoint = cp->bedSaved ? cp->newBedCheckpoint : cp->bedCheckpoint;
+    writer.header.headerChecksum = checksumUpdate(CHECKSUM_INIT, &writer.header,
+                                                  offsetof(struct SnapshotHeader, headerChecksum));
+    if (fseek(writer.file, 0, SEEK_SET) != 0 ||
+        fwrite(&writer.header, sizeof(writer.header), 1, writer.file) != 1) {
+        writer.failed = 1;
+    }
+    // 快照替换后会截去操作日志, 提交时先确保快照已落盘
+    if (!atomicFileCommit(writer.file, tempName, filename, writer.failed)) {
+        return 0;
+    }
+    if (!cp->quiet) {
+        printf("\n? 二进制快照保存成功！\n");
+    }
+    return 1;
+}
+
+// 快照是否不早于所有CSV文件 (CSV在程序外被修改过时应重新从CSV导入)
+int snapshotIsCurrent(const char* filename, const char* const* csvFiles, int csvCount) {
+    long long snapshotTime = fileModifiedTime(filename);
+    if (snapshotTime < 0) {
+        return 0;
+    }
+    for (int i = 0; i < csvCount; i++) {
+        if (fileModifiedTime(csvFiles[i]) > snapshotTime) {
+            printf("%s 比快照新，将从CSV文件加载\n", csvFiles[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// 校验快照文件头和各数据块, 返回数据块起始地址表; 无效时返回0
+int snapshotValidate(const struct MappedFile* mapped, const void* blocks[SNAPSHOT_BLOCK_COUNT]) {
+    static const unsigned int recordSizes[SNAPSHOT_BLOCK_COUNT] = {
+        sizeof(struct SnapshotPatient),
+        sizeof(struct SnapshotDoctor),
+        sizeof(struct SnapshotDoctorPatient),
+        sizeof(struct SnapshotDoctorWard)
+    };
+    if (mapped->size < (long long)sizeof(struct SnapshotHeader)) {
+        printf("快照文件不完整\n");
+        return 0;
+    }
+    const struct SnapshotHeader* header = (const struct SnapshotHeader*)mapped->data;
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != SNAPSHOT_VERSION || header->blockCount != SNAPSHOT_BLOCK_COUNT) {
+        printf("快照文件格式或版本不匹配\n");
+        return 0;
+    }
+    if (checksumUpdate(CHECKSUM_INIT, header, offsetof(struct SnapshotHeader, headerChecksum)) != header->headerChecksum) {
+        printf("快照文件头校验失败\n");
+        return 0;
+    }
+    for (int b = 0; b < SNAPSHOT_BLOCK_COUNT; b++) {
+        const struct SnapshotBlock* block = &header->blocks[b];
+        unsigned long long bytes = (unsigned long long)block->recordSize * block->count;
+        if (block->recordSize != recordSizes[b] || block->offset % 8 != 0 ||
+            block->offset > (unsigned long long)mapped->size ||
+            bytes > (unsigned long long)mapped->size - block->offset) {
+            printf("快照数据块 %d 的记录大小或范围无效\n", b);
+            return 0;
+        }
+        blocks[b] = mapped->data + block->offset;
+        unsigned int checksum = CHECKSUM_INIT;
+        const unsigned char* record = (const unsigned char*)blocks[b];
+        for (unsigned int i = 0; i < block->count; i++, record += block->recordSize) {
+            checksum = checksumUpdate(checksum, record, block->recordSize);
+        }
+        if (checksum != block->checksum) {
+            printf("快照数据块 %d 校验失败\n", b);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// 从二进制快照加载全部数据; 快照无效时不做任何修改并返回0, 由调用者改为加载CSV
+int loadSnapshot(const char* filename) {
+    struct MappedFile mapped;
+    if (!mappedFileOpen(&mapped, filename, 0)) {
+        return 0;
+    }
+    const void* blocks[SNAPSHOT_BLOCK_COUNT];
+    if (!snapshotValidate(&mapped, blocks)) {
+        mappedFileClose(&mapped);
+        printf("快照无效，将从CSV文件加载\n");
+        return 0;
+    }
+    const struct SnapshotHeader* header = (const struct SnapshotHeader*)mapped.data;
+    struct MappedFile bedMapped;
+    const struct SnapshotBed* beds = NULL;
+    if (mappedFileOpen(&bedMapped, BED_FILE, 0)) {
+        beds = bedFileValidate(&bedMapped, header->bedCheckpoint);
+        if (beds == NULL) {
+            mappedFileClose(&bedMapped);
+        }
+    }
+    if (beds == NULL) {
+        mappedFileClose(&mapped);
+        printf("床位检查点文件无效，将从CSV文件加载\n");
+        return 0;
+    }
+
+    printf("正在从二进制快照加载数据...\n");
+    double startTime = nowSeconds();
+    int counts[SNAPSHOT_BLOCK_COUNT];
+    for (int b = 0; b < SNAPSHOT_BLOCK_COUNT; b++) {
+        counts[b] = (int)header->blocks[b].count;
+    }
+    int loaded[SNAPSHOT_BLOCK_COUNT] = {0};
+
+    // 床位按槽位顺序插入, 使内存中的槽位与文件一致 (在院病人同时登记到病人表)
+    const struct BedFileHeader* bedHeader = (const struct BedFileHeader*)bedMapped.data;
+    int bedCount = bedHeader->count;
+    int bedsLoaded = 0;
+    int registered = 1;
+    bedStoreReserve(bedCount);
+    slabReserve(&bedPool, bedCount);
+    patientRegistryReserve(bedCount + counts[SnapshotPatients]);
+    for (int i = 0; i < bedCount; i++) {
+        const struct SnapshotBed* record = &beds[i];
+        if (findBedByID(record->ID) != NULL) {
+            continue;
+        }
+        struct Bed* bed = (struct Bed*)slabAlloc(&bedPool);
+        if (bed == NULL) {
+            break;
+        }
+        bedFromSnapshot(bed, record);
+        if (!bedStoreInsert(bed)) {
+            slabFree(&bedPool, bed);
+            break;
+        }
+        bedsLoaded++;
+        // 在院病人登记到病人表, 有病人重复或未能登记时病人表不完整
+        if (bed->isOccupied) {
+            if (findPatientByID(bed->patient.patientID) != NULL) {
+                registered = 0;
+            } else if (patientRegistryAdd(&bed->patient, bed) == NULL) {
+                registered = 0;
+            }
+        }
+    }
+    // 全部加载时文件与内存一致, 之后只需重写被修改的页
+    if (bedsLoaded == bedCount) {
+        bedFile.checkpoint = bedHeader->checkpoint;
+        bedFile.capacity = bedHeader->capacity;
+        if (bedFile.dirtyPages != NULL) {
+            memset(bedFile.dirtyPages, 0, bedFile.dirtyWords * sizeof(unsigned long long));
+        }
+    }
+    mappedFileClose(&bedMapped);
+
+    // 未分配床位的病人及候床状态
+    const struct SnapshotPatient* patients = (const struct SnapshotPatient*)blocks[SnapshotPatients];
+    for (int i = counts[SnapshotPatients] - 1; i >= 0; i--) {
+        const struct SnapshotPatient* record = &patients[i];
+        if (findPatientByID(record->patient.patientID) != NULL) {
+            continue;
+        }
+        struct PatientRecord* patient = patientRegistryAdd(&record->patient, NULL);
+        if (patient == NULL) {
+            break;
+        }
+        loaded[SnapshotPatients]++;
+        if (record->acuity != 0) {
+            waitlistAdd(patient, &record->request, record->acuity, record->waitSince, record->waitSeq);
+        }
+    }
+
+    // 医生
+    const struct SnapshotDoctor* doctors = (const struct SnapshotDoctor*)blocks[SnapshotDoctors];
+    doctorStoreReserve(counts[SnapshotDoctors]);
+    slabReserve(&doctorPool, counts[SnapshotDoctors]);
+    for (int i = counts[SnapshotDoctors] - 1; i >= 0; i--) {
+        const struct SnapshotDoctor* record = &doctors[i];
+        if (findDoctorByID(record->doctorID) != NULL) {
+            continue;
+        }
+        struct Doctor* doctor = (struct Doctor*)slabAlloc(&doctorPool);
+        if (doctor == NULL) {
+            break;
+        }
+        doctorFromSnapshot(doctor, record);
+        if (!doctorStoreInsert(doctor)) {
+            slabFree(&doctorPool, doctor);
+            break;
+        }
+        phoneIndexAdd(doctor->phone, PhoneOwnerDoctor, doctor);
+        loaded[SnapshotDoctors]++;
+    }
+
+    // 医生-病人关联
+    const struct SnapshotDoctorPatient* doctorPatients = (const struct SnapshotDoctorPatient*)blocks[SnapshotDoctorPatient];
+    slabReserve(&doctorPatientPool, counts[SnapshotDoctorPatient]);
+    relationSetReserve(&doctorPatientPairs, counts[SnapshotDoctorPatient]);
+    for (int i = counts[SnapshotDoctorPatient] - 1; i >= 0; i--) {
+        const struct SnapshotDoctorPatient* record = &doctorPatients[i];
+        if (findDoctorPatientRelation(record->doctorID, record->patientID) != NULL) {
+            continue;
+        }
+        struct DoctorPatientRelation* relation = (struct DoctorPatientRelation*)slabAlloc(&doctorPatientPool);
+        if (relation == NULL) {
+            break;
+        }
+        doctorPatientFromSnapshot(relation, record);
+        if (!doctorPatientLink(relation)) {
+            slabFree(&doctorPatientPool, relation);
+            break;
+        }
+        loaded[SnapshotDoctorPatient]++;
+    }
+    adjacencyCompact(&doctorPatientByDoctor);
+    adjacencyCompact(&doctorPatientByPatient);
+
+    // 医生-病房关联
+    const struct SnapshotDoctorWard* doctorWards = (const struct SnapshotDoctorWard*)blocks[SnapshotDoctorWard];
+    slabReserve(&doctorWardPool, counts[SnapshotDoctorWard]);
+    relationSetReserve(&doctorWardPairs, counts[SnapshotDoctorWard]);
+    for (int i = counts[SnapshotDoctorWard] - 1; i >= 0; i--) {
+        const struct SnapshotDoctorWard* record = &doctorWards[i];
+        if (findDoctorWardRelation(record->doctorID, record->wardNumber) != NULL) {
+            continue;
+        }
+        struct DoctorWardRelation* relation = (struct DoctorWardRelation*)slabAlloc(&doctorWardPool);
+        if (relation == NULL) {
+            break;
+        }
+        doctorWardFromSnapshot(relation, record);
+        if (!doctorWardLink(relation)) {
+            slabFree(&doctorWardPool, relation);
+            break;
+        }
+        loaded[SnapshotDoctorWard]++;
+    }
+    adjacencyCompact(&doctorWardByDoctor);
+    adjacencyCompact(&doctorWardByWard);
+
+    mappedFileClose(&mapped);
+
+    printf("快照加载完成: 床位 %d 条, 病人 %d 条, 医生 %d 条, 医生-病人关联 %d 条, 医生-病房关联 %d 条\n",
+           bedsLoaded, loaded[SnapshotPatients], loaded[SnapshotDoctors],
+           loaded[SnapshotDoctorPatient], loaded[SnapshotDoctorWard]);
+    if (bedsLoaded != bedCount) {
+        printf("警告: 床位检查点文件中有 %d 条记录重复或因内存不足未能加载\n", bedCount - bedsLoaded);
+    }
+    for (int b = 0; b < SNAPSHOT_BLOCK_COUNT; b++) {
+        if (loaded[b] != counts[b]) {
+            printf("警告: 数据块 %d 中有 %d 条记录重复或因内存不足未能加载\n", b, counts[b] - loaded[b]);
+        }
+    }
+    printf("  耗时 %.3f 秒\n", nowSeconds() - startTime);
+    patientTableComplete = registered && bedsLoaded == bedCount && loaded[SnapshotPatients] == counts[SnapshotPatients];
+    return 1;
+}
+
+// 操作日志 (预写日志): 每次修改以定长记录追加到日志, 记录实体修改后的完整状态或删除操作.
+// 一次菜单操作产生的所有记录 (包括级联删除和候床自动分配) 在操作结束时一起写入并刷盘;
+// 启动时在快照/CSV之上重放, 保存快照后清空. 记录类型见文件开头的enum JournalRecordType
+struct JournalFileHeader {
+    char magic[8];
+    unsigned int version;
+    unsigned int reserved;
+};
+
+struct JournalRecordHeader {
+    unsigned int size;          // 记录内容的字节数
+    unsigned short type;
+    unsigned short reserved;
+    unsigned int checksum;      // 类型和记录内容的校验和
+};
+
+// 删除操作的键 (床位ID/病人ID/医生ID, 关联关系另带病人ID或病房号)
+struct JournalKey {
+    int id;
+    int otherID;
+};
+
+struct Journal {
+    int recording;              // 加载和重放完成后才开始记录修改
+    FILE* file;                 // 日志文件, 无法打开时只记录修改代数
+    unsigned char* buffer;      // 尚未写入的记录
+    size_t length;
+    size_t capacity;
+    int failed;                 // 写入失败后不再记录, 避免日志出现缺口
+    long long written;          // 日志文件的长度 (已落盘的部分)
+};
+
+struct Journal journal = {0, NULL, NULL, 0, 0, 0, 0};
+
+// 记录类型所属的数据表
+int journalRecordTable(int type) {
+    return (type - 1) / 2;
+}
+
+// 将一条记录追加到日志缓冲区, 由journalCommit统一写入; 同时增加所属数据表的修改代数
+void journalAppend(int type, const void* data, unsigned int size) {
+    if (!journal.recording) {
+        return;
+    }
+    tableGeneration[journalRecordTable(type)]++;
+    if (journal.file == NULL || journal.failed) {
+        return;
+    }
+    size_t needed = journal.length + sizeof(struct JournalRecordHeader) + size;
+    if (needed > journal.capacity) {
+        size_t capacity = journal.capacity ? journal.capacity * 2 : 4096;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        unsigned char* buffer = (unsigned char*)realloc(journal.buffer, capacity);
+        if (buffer == NULL) {
+            printf("警告: 内存不足，操作日志已停用，请尽快保存退出\n");
+            journal.failed = 1;
+            return;
+        }
+        journal.buffer = buffer;
+        journal.capacity = capacity;
+    }
+    struct JournalRecordHeader header;
+    header.size = size;
+    header.type = (unsigned short)type;
+    header.reserved = 0;
+    header.checksum = checksumUpdate(checksumUpdate(CHECKSUM_INIT, &header.type, sizeof(header.type)), data, size);
+    memcpy(journal.buffer + journal.length, &header, sizeof(header));
+    memcpy(journal.buffer + journal.length + sizeof(header), data, size);
+    journal.length = needed;
+}
+
+void journalBed(const struct Bed* bed) {
+    struct SnapshotBed record;
+    snapshotFromBed(&record, bed);
+    journalAppend(JournalBedPut, &record, sizeof(record));
+}
+
+void journalPatient(const struct PatientRecord* patient) {
+    struct SnapshotPatient record;
+    snapshotFromPatient(&record, patient);
+    journalAppend(JournalPatientPut, &record, sizeof(record));
+}
+
+void journalDoctor(const struct Doctor* doctor) {
+    struct SnapshotDoctor record;
+    snapshotFromDoctor(&record, doctor);
+    journalAppend(JournalDoctorPut, &record, sizeof(record));
+}
+
+void journalDoctorPatient(const struct DoctorPatientRelation* relation) {
+    struct SnapshotDoctorPatient record;
+    snapshotFromDoctorPatient(&record, relation);
+    journalAppend(JournalDoctorPatientPut, &record, sizeof(record));
+}
+
+void journalDoctorWard(const struct DoctorWardRelation* relation) {
+    struct SnapshotDoctorWard record;
+    snapshotFromDoctorWard(&record, relation);
+    journalAppend(JournalDoctorWardPut, &record, sizeof(record));
+}
+
+void journalDelete(int type, int id, int otherID) {
+    struct JournalKey key = {id, otherID};
+    journalAppend(type, &key, sizeof(key));
+}
+
+// 将缓冲的记录写入日志并刷到磁盘 (组提交: 一次操作的多条记录只刷盘一次)
+void journalCommit() {
+    if (journal.file != NULL && journal.length > 0) {
+        if (!journal.failed) {
+            if (fwrite(journal.buffer, 1, journal.length, journal.file) != journal.length ||
+                fflush(journal.file) != 0 || fileSync(journal.file) != 0) {
+                printf("警告: 写入操作日志失败，之后的修改只能在检查点保存\n");
+                journal.failed = 1;
+            } else {
+                journal.written += (long long)journal.length;
+            }
+        }
+        journal.length = 0;
+    }
+    // 实时模式: 日志落盘后才原地写入床位页; 日志不可用时退出实时模式, 之后由检查点保存床位检查点文件
+    if (bedFileLive.data != NULL) {
+        if (journal.file != NULL && !journal.failed) {
+            bedFileLiveCommit();
+        } else {
+            bedFileLiveClose(0);
+        }
+    }
+}
+
+// 新建空日志文件 (只含文件头), 成功返回1
+int journalCreate() {
+    FILE* file = fopen(JOURNAL_FILE, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    struct JournalFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 && fflush(file) == 0 && fileSync(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+// 以追加方式打开日志, 之后的修改开始记录
+void journalOpen() {
+    journal.recording = 1;
+    journal.file = fopen(JOURNAL_FILE, "ab");
+    journal.failed = 0;
+    journal.length = 0;
+    if (journal.file == NULL) {
+        printf("警告: 无法打开操作日志 %s，修改只能在检查点保存\n", JOURNAL_FILE);
+        return;
+    }
+    journal.written = fileSizeOf(journal.file);
+}
+
+void journalClose() {
+    journalCommit();
+    if (journal.file != NULL) {
+        fclose(journal.file);
+        journal.file = NULL;
+    }
+    free(journal.buffer);
+    journal.buffer = NULL;
+    journal.length = 0;
+    journal.capacity = 0;
+}
+
+// 重放一条床位记录: 新建或覆盖床位状态, 并维护病人登记与床位的对应关系
+void journalApplyBed(const struct SnapshotBed* record) {
+    struct Bed* bed = findBedByID(record->ID);
+    if (bed == NULL) {
+        bed = (struct Bed*)slabAlloc(&bedPool);
+        if (bed == NULL) {
+            return;
+        }
+        bedFromSnapshot(bed, record);
+        if (!bedStoreInsert(bed)) {
+            slabFree(&bedPool, bed);
+            return;
+        }
+    } else {
+        bedFromSnapshot(bed, record);
+        bedStoreUpdate(bed);
+    }
+    if (bed->isOccupied) {
+        struct PatientRecord* patient = findPatientByID(bed->patient.patientID);
+        if (patient == NULL) {
+            patientRegistryAdd(&bed->patient, bed);
+        } else if (patient->bed == NULL) {
+            waitlistRemove(patient);
+            patient->bed = bed;
+        }
+    }
+}
+
+// 重放一条未分配床位病人的记录: 登记信息与候床状态整体覆盖
+void journalApplyPatient(const struct SnapshotPatient* record) {
+    struct PatientRecord* patient = findPatientByID(record->patient.patientID);
+    if (patient != NULL && patient->bed != NULL) {
+        return;
+    }
+    if (patient != NULL && memcmp(&patient->patient, &record->patient, sizeof(record->patient)) != 0) {
+        patientRegistryRemove(patient);     // 登记信息变化时重新登记, 以便更新文本和电话索引
+        patient = NULL;
+    }
+    if (patient == NULL) {
+        patient = patientRegistryAdd(&record->patient, NULL);
+        if (patient == NULL) {
+            return;
+        }
+    }
+    waitlistRemove(patient);
+    if (record->acuity != 0) {
+        waitlistAdd(patient, &record->request, record->acuity, record->waitSince, record->waitSeq);
+    }
+}
+
+void journalApplyDoctor(const struct SnapshotDoctor* record) {
+    struct Doctor* doctor = findDoctorByID(record->doctorID);
+    if (doctor == NULL) {
+        doctor = (struct Doctor*)slabAlloc(&doctorPool);
+        if (doctor == NULL) {
+            return;
+        }
+        doctorFromSnapshot(doctor, record);
+        if (!doctorStoreInsert(doctor)) {
+            slabFree(&doctorPool, doctor);
+            return;
+        }
+    } else {
+        phoneIndexRemove(doctor->phone, PhoneOwnerDoctor, doctor);
+        doctorLoadRemove(doctor);
+        doctorFromSnapshot(doctor, record);
+        doctorLoadAdd(doctor);
+    }
+    phoneIndexAdd(doctor->phone, PhoneOwnerDoctor, doctor);
+}
+
+void journalApplyDoctorPatient(const struct SnapshotDoctorPatient* record) {
+    struct DoctorPatientRelation* relation = findDoctorPatientRelation(record->doctorID, record->patientID);
+    if (relation != NULL) {
+        doctorPatientFromSnapshot(relation, record);
+        return;
+    }
+    relation = (struct DoctorPatientRelation*)slabAlloc(&doctorPatientPool);
+    if (relation == NULL) {
+        return;
+    }
+    doctorPatientFromSnapshot(relation, record);
+    if (!doctorPatientLink(relation)) {
+        slabFree(&doctorPatientPool, relation);
+    }
+}
+
+void journalApplyDoctorWard(const struct SnapshotDoctorWard* record) {
+    struct DoctorWardRelation* relation = findDoctorWardRelation(record->doctorID, record->wardNumber);
+    if (relation != NULL) {
+        doctorWardFromSnapshot(relation, record);
+        return;
+    }
+    relation = (struct DoctorWardRelation*)slabAlloc(&doctorWardPool);
+    if (relation == NULL) {
+        return;
+    }
+    doctorWardFromSnapshot(relation, record);
+    if (!doctorWardLink(relation)) {
+        slabFree(&doctorWardPool, relation);
+    }
+}
+
+// 重放一条删除记录 (对象已不存在时无操作)
+void journalApplyDelete(int type, const struct JournalKey* key) {
+    switch (type) {
+        case JournalBedDelete: {
+            struct Bed* bed = findBedByID(key->id);
+            if (bed != NULL) {
+                bedStoreRemove(bed);
+                slabFree(&bedPool, bed);
+            }
+            break;
+        }
+        case JournalPatientDelete: {
+            // 床位上的病人副本由随后的床位记录更新
+            struct PatientRecord* patient = findPatientByID(key->id);
+            if (patient != NULL) {
+                patientRegistryRemove(patient);
+            }
+            break;
+        }
+        case JournalDoctorDelete: {
+            struct Doctor* doctor = findDoctorByID(key->id);
+            if (doctor != NULL) {
+                doctorStoreRemove(doctor);
+                phoneIndexRemove(doctor->phone, PhoneOwnerDoctor, doctor);
+                slabFree(&doctorPool, doctor);
+            }
+            break;
+        }
+        case JournalDoctorPatientDelete: {
+            struct DoctorPatientRelation* relation = findDoctorPatientRelation(key->id, key->otherID);
+            if (relation != NULL) {
+                doctorPatientUnlink(relation);
+                slabFree(&doctorPatientPool, relation);
+            }
+            break;
+        }
+        case JournalDoctorWardDelete: {
+            struct DoctorWardRelation* relation = findDoctorWardRelation(key->id, key->otherID);
+            if (relation != NULL) {
+                doctorWardUnlink(relation);
+                slabFree(&doctorWardPool, relation);
+            }
+            break;
+        }
+    }
+}
+
+// 各类记录的内容大小, 0表示未知类型
+unsigned int journalRecordSize(int type) {
+    switch (type) {
+        case JournalBedPut: return sizeof(struct SnapshotBed);
+        case JournalPatientPut: return sizeof(struct SnapshotPatient);
+        case JournalDoctorPut: return sizeof(struct SnapshotDoctor);
+        case JournalDoctorPatientPut: return sizeof(struct SnapshotDoctorPatient);
+        case JournalDoctorWardPut: return sizeof(struct SnapshotDoctorWard);
+        case JournalBedDelete:
+        case JournalPatientDelete:
+        case JournalDoctorDelete:
+        case JournalDoctorPatientDelete:
+        case JournalDoctorWardDelete:
+            return sizeof(struct JournalKey);
+        default: return 0;
+    }
+}
+
+// 在已加载的数据之上重放日志, 然后打开日志继续记录.
+// 末尾不完整或校验失败的记录 (写入时崩溃) 被丢弃, 日志截断到最后一条完整记录
+void journalReplay() {
+    FILE* file = fopen(JOURNAL_FILE, "rb");
+    if (file == NULL) {
+        if (!journalCreate()) {
+            printf("警告: 无法创建操作日志 %s\n", JOURNAL_FILE);
+        }
+        journalOpen();
+        return;
+    }
+    long long size = fileSizeOf(file);
+    unsigned char* data = (unsigned char*)malloc(size > 0 ? (size_t)size : 1);
+    if (data == NULL || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        // 无法读取时保留原日志, 本次运行不记录, 退出保存后日志会被重建
+        printf("警告: 无法读取操作日志 %s，本次运行不记录操作日志\n", JOURNAL_FILE);
+        free(data);
+        fclose(file);
+        journal.recording = 1;
+        return;
+    }
+    fclose(file);
+
+    const struct JournalFileHeader* header = (const struct JournalFileHeader*)data;
+    if (size < (long long)sizeof(*header) || memcmp(header->magic, JOURNAL_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != JOURNAL_VERSION) {
+        printf("警告: 操作日志 %s 格式不正确，已忽略\n", JOURNAL_FILE);
+        free(data);
+        journalCreate();
+        journalOpen();
+        return;
+    }
+
+    double startTime = nowSeconds();
+    long long offset = sizeof(struct JournalFileHeader);
+    int applied = 0;
+    while (offset + (long long)sizeof(struct JournalRecordHeader) <= size) {
+        struct JournalRecordHeader record;
+        memcpy(&record, data + offset, sizeof(record));
+        const unsigned char* body = data + offset + sizeof(record);
+        if (record.size != journalRecordSize(record.type) ||
+            offset + (long long)sizeof(record) + record.size > size ||
+            checksumUpdate(checksumUpdate(CHECKSUM_INIT, &record.type, sizeof(record.type)), body, record.size) != record.checksum) {
+            break;
+        }
+        // 记录在缓冲区中不一定对齐, 先复制出来
+        union {
+            struct SnapshotBed bed;
+            struct SnapshotPatient patient;
+            struct SnapshotDoctor doctor;
+            struct SnapshotDoctorPatient doctorPatient;
+            struct SnapshotDoctorWard doctorWard;
+            struct JournalKey key;
+        } payload;
+        memcpy(&payload, body, record.size);
+        switch (record.type) {
+            case JournalBedPut: journalApplyBed(&payload.bed); break;
+            case JournalPatientPut: journalApplyPatient(&payload.patient); break;
+            case JournalDoctorPut: journalApplyDoctor(&payload.doctor); break;
+            case JournalDoctorPatientPut: journalApplyDoctorPatient(&payload.doctorPatient); break;
+            case JournalDoctorWardPut: journalApplyDoctorWard(&payload.doctorWard); break;
+            default: journalApplyDelete(record.type, &payload.key); break;
+        }
+        tableGeneration[journalRecordTable(record.type)]++;     // 重放的修改尚未保存到CSV
+        applied++;
+        offset += sizeof(record) + record.size;
+    }
+
+    if (offset < size) {
+        // 截断损坏的尾部: 只保留完整记录, 经临时文件替换
+        printf("警告: 操作日志末尾有 %lld 字节不完整 (上次写入时中断)，已丢弃\n", size - offset);
+        char tempName[260];
+        FILE* temp = atomicFileOpen(JOURNAL_FILE, tempName, "wb");
+        if (temp == NULL ||
+            !atomicFileCommit(temp, tempName, JOURNAL_FILE, fwrite(data, 1, (size_t)offset, temp) != (size_t)offset)) {
+            printf("警告: 无法截断操作日志，本次运行不记录操作日志\n");
+            free(data);
+            journal.recording = 1;
+            return;
+        }
+    }
+    free(data);
+    if (applied > 0) {
+        printf("已重放操作日志中的 %d 条记录，耗时 %.3f 秒\n", applied, nowSeconds() - startTime);
+    }
+    journalOpen();
+}
+
+// 检查点完成后截去日志中已包含在检查点中的部分: 先不持有存储锁将之后的记录复制到临时文件并刷盘,
+// 再持有存储锁补上复制期间追加的记录并替换日志, 菜单操作只需等待少量记录的写入
+struct JournalCompaction {
+    FILE* temp;                 // 新日志的临时文件, 未能创建时为NULL
+    char tempName[260];
+    long long copied;           // 已复制到的原日志位置
+};
+
+// 将日志文件[from, to)范围的内容追加到out, 成功返回1
+int journalCopyRange(FILE* out, long long from, long long to) {
+    FILE* file = fopen(JOURNAL_FILE, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    int ok = fileSeek(file, from) == 0;
+    unsigned char buffer[16384];
+    while (ok && from < to) {
+        size_t chunk = to - from < (long long)sizeof(buffer) ? (size_t)(to - from) : sizeof(buffer);
+        ok = fread(buffer, 1, chunk, file) == chunk && fwrite(buffer, 1, chunk, out) == chunk;
+        from += (long long)chunk;
+    }
+    fclose(file);
+    return ok;
+}
+
+// 第一阶段 (不持有存储锁): 写入文件头和日志[offset, end)的记录并刷盘, end为已落盘的日志长度
+void journalCompactBegin(struct JournalCompaction* c, long long offset, long long end) {
+    c->copied = offset;
+    c->temp = atomicFileOpen(JOURNAL_FILE, c->tempName, "wb");
+    if (c->temp == NULL) {
+        return;
+    }
+    struct JournalFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    if (fwrite(&header, sizeof(header), 1, c->temp) != 1 || !journalCopyRange(c->temp, offset, end) ||
+        fflush(c->temp) != 0 || fileSync(c->temp) != 0) {
+        atomicFileCommit(c->temp, c->tempName, JOURNAL_FILE, 1);     // 失败时只删除临时文件
+        c->temp = NULL;
+        return;
+    }
+    c->copied = end;
+}
+
+// 第二阶段 (调用者持有存储锁): 补上复制期间追加的记录后替换日志. 日志不可用时丢弃临时文件,
+// 只有复制后没有新的修改才能从空日志重新开始记录. c为NULL表示未执行第一阶段
+void journalCompactFinish(struct JournalCompaction* c, const unsigned long long* generation) {
+    if (journal.file == NULL || journal.failed) {
+        if (c != NULL && c->temp != NULL) {
+            fclose(c->temp);
+            remove(c->tempName);
+        }
+        for (int t = 0; t < TABLE_COUNT; t++) {
+            if (tableGeneration[t] != generation[t]) {
+                return;
+            }
+        }
+        journalClose();
+        if (journalCreate()) {
+            journalOpen();
+        }
+        return;
+    }
+    if (c == NULL || c->temp == NULL) {
+        return;
+    }
+    int failed = !journalCopyRange(c->temp, c->copied, journal.written);
+    // 替换前关闭追加句柄 (Windows上不能替换已打开的文件)
+    fclose(journal.file);
+    journal.file = NULL;
+    atomicFileCommit(c->temp, c->tempName, JOURNAL_FILE, failed);
+    journalOpen();
+}
+
+// 添加医生记录
+void addDoctor() {
+    printOperationTitle("添加医生记录");
+    
+    struct Doctor* newDoctor = (struct Doctor*)slabAlloc(&doctorPool);
+    if (newDoctor == NULL) {
+        printf("内存分配失败\n");
+        waitForEnter();
+        return;
+    }
+
+    printf("输入医生ID: ");
+    scanf("%d", &newDoctor->doctorID);
+    flushStdin(); // 清空输入缓冲区
+    
+    // 检查ID是否已存在
+    if (findDoctorByID(newDoctor->doctorID) != NULL) {
+        printf("错误: 医生ID %d 已存在，请使用其他ID\n", newDoctor->doctorID);
+        slabFree(&doctorPool, newDoctor);
+        waitForEnter();
+        return;
+    }
+    
+    // 获取医生其他信息
+    printf("输入医生姓名: ");
+    scanf("%s", newDoctor->name);
+    flushStdin();
+    
+    printf("输入医生性别 (1男, 0女): ");
+    scanf("%d", &newDoctor->gender);
+    flushStdin();
+    
+    printf("输入医生电话: ");
+    scanf("%s", newDoctor->phone);
+    flushStdin();
+    
+    printf("输入所属科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+    scanf("%d", &newDoctor->department);
+    flushStdin();
+    
+    printf("输入专业/专长: ");
+    scanf(" %[^\n]", newDoctor->specialization);
+    flushStdin();
+    
+    printf("输入职称 (1-住院医师, 2-主治医师, 3-副主任医师, 4-主任医师): ");
+    scanf("%d", &newDoctor->qualification);
+    flushStdin();
+    
+    printf("输入办公室位置: ");
+    scanf(" %[^\n]", newDoctor->officeLocation);
+    flushStdin();
+    
+    // 加入索引和链表
+    storeBegin();
+    if (!doctorStoreInsert(newDoctor)) {
+        printf("内存分配失败\n");
+        slabFree(&doctorPool, newDoctor);
+        waitForEnter();
+        return;
+    }
+    phoneIndexAdd(newDoctor->phone, PhoneOwnerDoctor, newDoctor);
+
+    printf("\n? 医生添加成功！新增医生信息如下：\n");
+    printSeparator();
+    printDoctorBasicInfo(newDoctor);
+    printf("\n");
+    printSeparator();
+    waitForEnter();
+}
+
+// 修改医生信息
+void modifyDoctor() {
+    printOperationTitle("修改医生信息");
+    
+    int id;
+    printf("输入要修改的医生ID: ");
+    scanf("%d", &id);
+    flushStdin();
+
+    struct Doctor* current = findDoctorByID(id);
+    if (current != NULL) {
+        printf("\n当前医生信息：\n");
+        printSeparator();
+        printDoctorBasicInfo(current);
+        printf("\n");
+        printSeparator();
+        
+        // 先读入副本, 输入完成后再持有存储锁修改医生记录
+        struct Doctor input = *current;
+        printf("\n请输入新的信息：\n");
+        printf("输入新的姓名: ");
+        scanf("%s", input.name);
+        flushStdin();
+        
+        printf("输入新的性别 (1男, 0女): ");
+        scanf("%d", &input.gender);
+        flushStdin();
+        
+        printf("输入新的电话: ");
+        scanf("%s", input.phone);
+        flushStdin();
+        
+        printf("输入新的科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+        scanf("%d", &input.department);
+        flushStdin();
+        
+        printf("输入新的专业/专长: ");
+        scanf(" %[^\n]", input.specialization);
+        flushStdin();
+        
+        printf("输入新的职称 (1-住院医师, 2-主治医师, 3-副主任医师, 4-主任医师): ");
+        scanf("%d", &input.qualification);
+        flushStdin();
+        
+        printf("输入新的办公室位置: ");
+        scanf(" %[^\n]", input.officeLocation);
+        flushStdin();
+        
+        storeBegin();
+        phoneIndexRemove(current->phone, PhoneOwnerDoctor, current);
+        // 科室和职称决定医生在负载堆中的位置, 修改后重新入堆
+        doctorLoadRemove(current);
+        memcpy(current->name, input.name, sizeof(current->name));
+        current->gender = input.gender;
+        memcpy(current->phone, input.phone, sizeof(current->phone));
+        current->department = input.department;
+        memcpy(current->specialization, input.specialization, sizeof(current->specialization));
+        current->qualification = input.qualification;
+        memcpy(current->officeLocation, input.officeLocation, sizeof(current->officeLocation));
+        phoneIndexAdd(current->phone, PhoneOwnerDoctor, current);
+        if (!doctorLoadAdd(current)) {
+            printf("警告: 内存分配失败，该医生暂不参与自动分配\n");
+        }
+        journalDoctor(current);
+        
+        printf("\n? 医生信息修改成功！更新后信息如下：\n");
+        printSeparator();
+        printDoctorBasicInfo(current);
+        printf("\n");
+        printSeparator();
+        waitForEnter();
+        return;
+    }
+
+    printf("\n? 未找到医生ID为%d的医生\n", id);
+    waitForEnter();
+}
+
+// 检查医生是否有关联的病人
+int doctorHasPatients(int doctorID) {
+    return adjacencyDegree(&doctorPatientByDoctor, doctorID) > 0;
+}
+
+// 检查医生是否有关联的病房
+int doctorHasWards(int doctorID) {
+    return adjacencyDegree(&doctorWardByDoctor, doctorID) > 0;
+}
+
+// 删除医生记录
+void deleteDoctor() {
+    printOperationTitle("删除医生记录");
+    
+    int id;
+    printf("输入要删除的医生ID: ");
+    scanf("%d", &id);
+    flushStdin();
+
+    struct Doctor* current = findDoctorByID(id);
+    if (current != NULL) {
+        // 医生仍有关联的病人或病房时, 可选择级联解除后删除
+        if (doctorHasPatients(id) || doctorHasWards(id)) {
+            printf("\n医生ID %d 当前有 %d 条病人关联和 %d 条病房关联\n", id,
+                   adjacencyDegree(&doctorPatientByDoctor, id), adjacencyDegree(&doctorWardByDoctor, id));
+            printf("是否一并解除这些关联并删除医生? (病人关联将归档) (1确认, 0取消): ");
+            int cascade;
+            scanf("%d", &cascade);
+            flushStdin();
+            if (!cascade) {
+                printf("\n操作已取消\n");
+                waitForEnter();
+                return;
+            }
+            int patients, wards;
+            storeBegin();
+            cascadeDoctorRelations(id, &patients, &wards);
+            printf("已解除 %d 条病人关联和 %d 条病房关联\n", patients, wards);
+        }
+        
+        storeBegin();
+        doctorStoreRemove(current);
+        phoneIndexRemove(current->phone, PhoneOwnerDoctor, current);
+        slabFree(&doctorPool, current);
+        printf("\n? 医生ID为%d的记录删除成功\n", id);
+        waitForEnter();
+        return;
+    }
+
+    printf("\n? 未找到医生ID为%d的医生\n", id);
+    waitForEnter();
+}
+
+// 根据ID查询医生信息
+void searchDoctorByID() {
+    printOperationTitle("医生信息查询");
+    
+    int id;
+    printf("输入要查找的医生ID: ");
+    scanf("%d", &id);
+    flushStdin();
+
+    struct Doctor* current = findDoctorByID(id);
+    if (current != NULL) {
+        printf("\n查询结果：\n");
+        printSeparator();
+        printDoctorBasicInfo(current);
+        printf("\n");
+        printSeparator();
+        
+        // 查询该医生负责的病人
+        printf("\n该医生负责的病人列表：\n");
+        printSeparator();
+        int patientCount;
+        void** dpRelations = adjacencyEdges(&doctorPatientByDoctor, id, &patientCount);
+        for (int i = 0; i < patientCount; i++) {
+            struct DoctorPatientRelation* dpRelation = (struct DoctorPatientRelation*)dpRelations[i];
+            printf("病人ID: %d | 医疗备注: %s | 开始日期: %s\n", 
+                   dpRelation->patientID, dpRelation->notes, dpRelation->startDate);
+        }
+        
+        if (patientCount == 0) {
+            printf("该医生暂无负责的病人\n");
+        }
+        printSeparator();
+        
+        // 查询该医生负责的病房
+        printf("\n该医生负责的病房列表：\n");
+        printSeparator();
+        int wardCount;
+        void** dwRelations = adjacencyEdges(&doctorWardByDoctor, id, &wardCount);
+        for (int i = 0; i < wardCount; i++) {
+            struct DoctorWardRelation* dwRelation = (struct DoctorWardRelation*)dwRelations[i];
+            printf("病房号: %d | 主治医生: %s | 查房安排: %s\n", 
+                   dwRelation->wardNumber, 
+                   dwRelation->isHeadDoctor ? "是" : "否", 
+                   dwRelation->scheduleInfo);
+        }
+        
+        if (wardCount == 0) {
+            printf("该医生暂无负责的病房\n");
+        }
+        printSeparator();
+        
+        waitForEnter();
+        return;
+    }
+
+    printf("\n? 未找到医生ID为%d的医生\n", id);
+    waitForEnter();
+}
+
+// 列出所有医生信息
+void listAllDoctors() {
+    printOperationTitle("所有医生信息");
+    
+    struct Doctor* current = doctorHead;
+    if (current == NULL) {
+        printf("当前没有医生信息\n");
+        waitForEnter();
+        return;
+    }
+    
+    int count = 0;
+    int deptCount[6] = {0}; // 用于统计各科室医生数量，索引0未使用
+    
+    printf("所有医生列表：\n");
+    printf("----------------------------------------------------------------\n");
+    
+    while (current != NULL) {
+        printDoctorBasicInfo(current);
+        printf("\n----------------------------------------------------------------\n");
+        
+        // 统计各科室医生数量
+        if (current->department >= 1 && current->department <= 5) {
+            deptCount[current->department]++;
+        }
+        
+        current = current->next;
+        count++;
+    }
+    
+    printf("\n统计信息：总医生数: %d | ", count);
+    printf("内科: %d | 外科: %d | 儿科: %d | 妇科: %d | 其他: %d\n", 
+           deptCount[1], deptCount[2], deptCount[3], deptCount[4], deptCount[5]);
+    
+    waitForEnter();
+}
+
+// 按电话号码前缀或尾号查询病人和医生
+void searchByPhone() {
+    printOperationTitle("按电话号码查询");
+    
+    int mode;
+    char query[PHONE_KEY_MAX];
+    printf("选择查询方式 (1号码前缀, 2号码尾号): ");
+    scanf("%d", &mode);
+    flushStdin();
+    
+    printf("输入号码片段: ");
+    if (scanf("%19s", query) != 1) {
+        query[0] = '\0';
+    }
+    flushStdin();
+    
+    if ((mode != 1 && mode != 2) || query[0] == '\0') {
+        printf("\n? 无效的查询条件\n");
+        waitForEnter();
+        return;
+    }
+    
+    // 尾号查询在逆序树中按逆序的片段做前缀查询
+    struct PhoneTrieNode* node;
+    if (mode == 1) {
+        node = phoneTrieLocate(&phonePrefixRoot, query, (int)strlen(query));
+    } else {
+        char reversed[PHONE_KEY_MAX];
+        int length = reversePhone(query, reversed);
+        node = phoneTrieLocate(&phoneSuffixRoot, reversed, length);
+    }
+    
+    struct PhoneEntry* results[PHONE_QUERY_LIMIT];
+    int total = node != NULL ? node->count : 0;
+    int n = node != NULL ? phoneTrieCollect(node, results, 0, PHONE_QUERY_LIMIT) : 0;
+    
+    printf("\n查询结果：\n");
+    printf("----------------------------------------------------------------\n");
+    for (int i = 0; i < n; i++) {
+        if (results[i]->kind == PhoneOwnerDoctor) {
+            printf("[医生] ");
+            printDoctorBasicInfo((struct Doctor*)results[i]->owner);
+            printf("\n");
+        } else {
+            struct PatientRecord* record = (struct PatientRecord*)results[i]->owner;
+            printf("[病人] 病人ID: %d | 姓名: %s | 电话: %s | ",
+                   record->patient.patientID, record->patient.name, record->patient.phone);
+            if (record->bed != NULL) {
+                printf("床位ID: %d | 病房: %d\n", record->bed->ID, record->bed->ward);
+            } else {
+                printf("未分配床位\n");
+            }
+        }
+    }
+    printf("----------------------------------------------------------------\n");
+    if (total == 0) {
+        printf("没有匹配的电话号码\n");
+    } else {
+        printf("\n? 共找到 %d 条记录", total);
+        if (total > n) {
+            printf("，仅显示前 %d 条，请输入更长的号码片段缩小范围", n);
+        }
+        printf("\n");
+    }
+    waitForEnter();
+}
+
+// 检查病人是否存在
+int patientExists(int patientID) {
+    return findPatientByID(patientID) != NULL;
+}
+
+// 检查病房是否存在
+int wardExists(int wardNumber) {
+    struct WardIndex* ward = findWardIndex(wardNumber);
+    return ward != NULL && ward->counter.total > 0;
+}
+
+// 检查医生是否存在
+int doctorExists(int doctorID) {
+    return findDoctorByID(doctorID) != NULL;
+}
+
+// 检查医生-病人关联是否已存在
+int doctorPatientRelationExists(int doctorID, int patientID) {
+    return findDoctorPatientRelation(doctorID, patientID) != NULL;
+}
+
+// 检查医生-病房关联是否已存在
+int doctorWardRelationExists(int doctorID, int wardNumber) {
+    return findDoctorWardRelation(doctorID, wardNumber) != NULL;
+}
+
+// 分配病人给医生
+// 选出科室中负载最低且尚未负责该病人的医生, 通常直接取堆顶 O(1); 科室无可选医生时返回NULL
+struct Doctor* pickLeastLoadedDoctor(int department, int patientID) {
+    struct DoctorLoadHeap* heap = &doctorLoadHeaps[departmentBitmapIndex(department)];
+    if (heap->count == 0) {
+        return NULL;
+    }
+    if (!doctorPatientRelationExists(heap->items[0]->doctorID, patientID)) {
+        return heap->items[0];
+    }
+    // 堆顶已负责该病人 (少见), 在其余医生中线性查找
+    struct Doctor* best = NULL;
+    for (int i = 1; i < heap->count; i++) {
+        struct Doctor* doctor = heap->items[i];
+        if ((best == NULL || doctorLoadBefore(doctor, best)) &&
+            !doctorPatientRelationExists(doctor->doctorID, patientID)) {
+            best = doctor;
+        }
+    }
+    return best;
+}
+
+// 自动分配模式: 按病人所在床位的科室 (未分配床位时手动输入) 选出负载最低的医生, 失败返回NULL
+struct Doctor* chooseDoctorByLoad(int patientID) {
+    struct PatientRecord* record = findPatientByID(patientID);
+    int department;
+    if (record->bed != NULL) {
+        department = record->bed->department;
+        printf("病人所在科室: ");
+        printDepartment(department);
+        printf("\n");
+    } else {
+        printf("病人尚未分配床位, 输入科室编号 (1-内科, 2-外科, 3-儿科, 4-妇科, 5-其他): ");
+        scanf("%d", &department);
+        flushStdin();
+    }
+    
+    printf("是否按职称加权负载 (1是, 0否): ");
+    int weighted;
+    scanf("%d", &weighted);
+    flushStdin();
+    doctorLoadSetWeighted(weighted);
+    
+    struct Doctor* doctor = pickLeastLoadedDoctor(department, patientID);
+    if (doctor == NULL) {
+        printf("\n? 错误：该科室没有可分配的医生\n");
+        return NULL;
+    }
+    printf("自动选择医生: ID %d | 姓名: %s | 当前负责病人数: %d\n",
+           doctor->doctorID, doctor->name, doctor->caseload);
+    return doctor;
+}
+
+void assignPatientToDoctor() {
+    printOperationTitle("分配病人给医生");
+    
+    int mode, doctorID = 0, patientID;
+    
+    // 医生ID可以是任意整数, 自动分配作为单独的选项而不占用某个ID
+    printf("选择分配方式 (1指定医生, 2按科室负载自动分配): ");
+    scanf("%d", &mode);
+    flushStdin();
+    if (mode != 1 && mode != 2) {
+        printf("\n? 无效的分配方式\n");
+        waitForEnter();
+        return;
+    }
+    
+    if (mode == 1) {
+        printf("输入医生ID: ");
+        scanf("%d", &doctorID);
+        flushStdin();
+        
+        // 检查医生是否存在
+        if (!doctorExists(doctorID)) {
+            printf("\n? 错误：医生ID %d 不存在\n", doctorID);
+            waitForEnter();
+            return;
+        }
+    }
+    
+    printf("输入病人ID: ");
+    scanf("%d", &patientID);
+    flushStdin();
+    
+    // 检查病人是否存在
+    if (!patientExists(patientID)) {
+        printf("\n? 错误：病人ID %d 不存在\n", patientID);
+        waitForEnter();
+        return;
+    }
+    
+    if (mode == 2) {
+        struct Doctor* doctor = chooseDoctorByLoad(patientID);
+        if (doctor == NULL) {
+            waitForEnter();
+            return;
+        }
+        doctorID = doctor->doctorID;
+    }
+    
+    // 检查关联是否已存在
+    if (doctorPatientRelationExists(doctorID, patientID)) {
+        printf("\n? 错误：医生ID %d 与病人ID %d 的关联已存在\n", doctorID, patientID);
+        waitForEnter();
+        return;
+    }
+    
+    // 创建新的关联记录
+    struct DoctorPatientRelation* newRelation = (struct DoctorPatientRelation*)slabAlloc(&doctorPatientPool);
+    if (newRelation == NULL) {
+        printf("内存分配失败\n");
+        waitForEnter();
+        return;
+    }
+    
+    newRelation->doctorID = doctorID;
+    newRelation->patientID = patientID;
+    
+    printf("输入医疗备注: ");
+    scanf(" %[^\n]", newRelation->notes);
+    flushStdin();
+    
+    printf("输入开始负责日期 (格式: YYYY-MM-DD): ");
+    scanf("%s", newRelation->startDate);
+    flushStdin();
+    
+    // 加入链表、查重集合和邻接索引
+    storeBegin();
+    if (!doctorPatientLink(newRelation)) {
+        printf("内存分配失败\n");
+        slabFree(&doctorPatientPool, newRelation);
+        waitForEnter();
+        return;
+    }
+    
+    printf("\n? 医生-病人关联建立成功！\n");
+    printf("医生ID: %d | 病人ID: %d | 医疗备注: %s | 开始日期: %s\n", 
+           newRelation->doctorID, newRelation->patientID, newRelation->notes, newRelation->startDate);
+    
+    waitForEnter();
+}
+
+// 解除医生与病人的关联
+void removePatientFromDoctor() {
+    printOperationTitle("解除医生-病人关联");
+    
+    int doctorID, patientID;
+    
+    printf("输入医生ID: ");
+    scanf("%d", &doctorID);
+    flushStdin();
+    
+    printf("输入病人ID: ");
+    scanf("%d", &patientID);
+    flushStdin();
+    
+    struct DoctorPatientRelation* current = findDoctorPatientRelation(doctorID, patientID);
+    if (current != NULL) {
+        printf("\n将要删除的关联信息：\n");
+        printf("医生ID: %d | 病人ID: %d | 医疗备注: %s | 开始日期: %s\n", 
+               current->doctorID, current->patientID, current->notes, current->startDate);
+        
+        printf("\n确认删除? (1确认, 0取消): ");
+        int confirm;
+        scanf("%d", &confirm);
+        flushStdin();
+        
+        if (confirm) {
+            storeBegin();
+            doctorPatientUnlink(current);
+            slabFree(&doctorPatientPool, current);
+            printf("\n? 医生-病人关联解除成功\n");
+        } else {
+            printf("\n操作已取消\n");
+        }
+        
+        waitForEnter();
+        return;
+    }
+    
+    printf("\n? 未找到医生ID %d 和病人ID %d 的关联记录\n", doctorID, patientID);
+    waitForEnter();
+}
+
+// 查询医生负责的所有病人
+void listPatientsByDoctor() {
+    printOperationTitle("查询医生负责的病人");
+    
+    int doctorID;
+    printf("输入医生ID: ");
+    scanf("%d", &doctorID);
+    flushStdin();
+    
+    // 检查医生是否存在
+    if (!doctorExists(doctorID)) {
+        printf("\n? 错误：医生ID %d 不存在\n", doctorID);
+        waitForEnter();
+        return;
+    }
+    
+    // 显示医生基本信息
+    printf("\n医生信息：\n");
+    printSeparator();
+    printDoctorBasicInfo(findDoctorByID(doctorID));
+    printf("\n");
+    printSeparator();
+    
+    // 显示该医生负责的病人列表
+    printf("\n该医生负责的病人列表：\n");
+    printSeparator();
+    
+    int count = 0;
+    int degree;
+    void** edges = adjacencyEdges(&doctorPatientByDoctor, doctorID, &degree);
+    
+    for (int i = 0; i < degree; i++) {
+        struct DoctorPatientRelation* relation = (struct DoctorPatientRelation*)edges[i];
+        // 查找病人详细信息
+        struct PatientRecord* record = findPatientByID(relation->patientID);
+        if (record != NULL) {
+            printf("病人ID: %d | 姓名: %s | 诊断: %s | ",
+                   record->patient.patientID, record->patient.name, record->patient.diagnosis);
+            if (record->bed != NULL) {
+                printf("床位ID: %d | 病房: %d\n", record->bed->ID, record->bed->ward);
+            } else {
+                printf("未分配床位\n");
+            }
+            printf("医疗备注: %s | 开始负责日期: %s\n",
+                   relation->notes, relation->startDate);
+            printf("----------------------------------------------------------------\n");
+            count++;
+        } else {
+            // 如果找不到该病人信息，只显示关联信息
+            printf("病人ID: %d | 医疗备注: %s | 开始负责日期: %s\n",
+                   relation->patientID, relation->notes, relation->startDate);
+            printf("(注: 未找到该病人的详细信息)\n");
+            printf("----------------------------------------------------------------\n");
+            count++;
+        }
+    }
+    
+    if (count == 0) {
+        printf("该医生暂无负责的病人\n");
+    } else {
+        printf("\n? 共找到 %d 条病人记录\n", count);
+    }
+    
+    waitForEnter();
+}
+
+// 查询病人的主治医生
+void listDoctorsByPatient() {
+    printOperationTitle("查询病人的医生");
+    
+    int patientID;
+    printf("输入病人ID: ");
+    scanf("%d", &patientID);
+    flushStdin();
+    
+    // 检查病人是否存在
+    if (!patientExists(patientID)) {
+        printf("\n? 错误：病人ID %d 不存在\n", patientID);
+        waitForEnter();
+        return;
+    }
+    
+    // 显示病人基本信息
+    printf("\n病人信息：\n");
+    printSeparator();
+    printPatientRecord(findPatientByID(patientID));
+    printSeparator();
+    
+    // 显示负责该病人的医生列表
+    printf("\n负责该病人的医生列表：\n");
+    printSeparator();
+    
+    int count = 0;
+    int degree;
+    void** edges = adjacencyEdges(&doctorPatientByPatient, patientID, &degree);
+    
+    for (int i = 0; i < degree; i++) {
+        struct DoctorPatientRelation* relation = (struct DoctorPatientRelation*)edges[i];
+        // 查找医生详细信息
+        struct Doctor* doctor = findDoctorByID(relation->doctorID);
+        if (doctor != NULL) {
+            printDoctorBasicInfo(doctor);
+            printf("\n医疗备注: %s | 开始负责日期: %s\n",
+                   relation->notes, relation->startDate);
+            printf("----------------------------------------------------------------\n");
+            count++;
+        } else {
+            // 如果找不到该医生信息，只显示关联信息
+            printf("医生ID: %d | 医疗备注: %s | 开始负责日期: %s\n",
+                   relation->doctorID, relation->notes, relation->startDate);
+            printf("(注: 未找到该医生的详细信息)\n");
+            printf("----------------------------------------------------------------\n");
+            count++;
+        }
+    }
+    
+    if (count == 0) {
+        printf("该病人暂无负责的医生\n");
+    } else {
+        printf("\n? 共找到 %d 条医生记录\n", count);
+    }
+    
+    waitForEnter();
+}
+
+// 分配病房给医生
+void assignWardToDoctor() {
+    printOperationTitle("分配病房给医生");
+    
+    int doctorID, wardNumber;
+    
+    printf("输入医生ID: ");
+    scanf("%d", &doctorID);
+    flushStdin();
+    
+    // 检查医生是否存在
+    if (!doctorExists(doctorID)) {
+        printf("\n? 错误：医生ID %d 不存在\n", doctorID);
+        waitForEnter();
+        return;
+    }
+    
+    printf("输入病房号: ");
+    scanf("%d", &wardNumber);
+    flushStdin();
+    
+    // 检查病房是否存在
+    if (!wardExists(wardNumber)) {
+        printf("\n? 错误：病房号 %d 不存在\n", wardNumber);
+        waitForEnter();
+        return;
+    }
+    
+    // 检查关联是否已存在
+    if (doctorWardRelationExists(doctorID, wardNumber)) {
+        printf("\n? 错误：医生ID %d 与病房号 %d 的关联已存在\n", doctorID, wardNumber);
+        waitForEnter();
+        return;
+    }
+    
+    // 创建新的关联记录
+    struct DoctorWardRelation* newRelation = (struct DoctorWardRelation*)slabAlloc(&doctorWardPool);
+    if (newRelation == NULL) {
+        printf("内存分配失败\n");
+        waitForEnter();
+        return;
+    }
+    
+    newRelation->doctorID = doctorID;
+    newRelation->wardNumber = wardNumber;
+    
+    printf("是否为主治医生 (1是, 0否): ");
+    scanf("%d", &newRelation->isHeadDoctor);
+    flushStdin();
+    
+    printf("输入查房安排: ");
+    scanf(" %[^\n]", newRelation->scheduleInfo);
+    flushStdin();
+    
+    // 加入链表、查重集合和邻接索引
+    storeBegin();
+    if (!doctorWardLink(newRelation)) {
+        printf("内存分配失败\n");
+        slabFree(&doctorWardPool, newRelation);
+        waitForEnter();
+        return;
+    }
+    
+    printf("\n? 医生-病房关联建立成功！\n");
+    printf("医生ID: %d | 病房号: %d | 主治医生: %s | 查房安排: %s\n", 
+           newRelation->doctorID, newRelation->wardNumber, 
+           newRelation->isHeadDoctor ? "是" : "否", newRelation->scheduleInfo);
+    
+    waitForEnter();
+}
+
+// 解除医生与病房的关联
+void removeWardFromDoctor() {
+    printOperationTitle("解除医生-病房关联");
+    
+    int doctorID, wardNumber;
+    
+    printf("输入医生ID: ");
+    scanf("%d", &doctorID);
+    flushStdin();
+    
+    printf("输入病房号: ");
+    scanf("%d", &wardNumber);
+    flushStdin();
+    
+    struct DoctorWardRelation* current = findDoctorWardRelation(doctorID, wardNumber);
+    if (current != NULL) {
+        printf("\n将要删除的关联信息：\n");
+        printf("医生ID: %d | 病房号: %d | 主治医生: %s | 查房安排: %s\n", 
+               current->doctorID, current->wardNumber, 
+               current->isHeadDoctor ? "是" : "否", current->scheduleInfo);
+        
+        printf("\n确认删除? (1确认, 0取消): ");
+        int confirm;
+        scanf("%d", &confirm);
+        flushStdin();
+        
+        if (confirm) {
+            storeBegin();
+            doctorWardUnlink(current);
+            slabFree(&doctorWardPool, current);
+            printf("\n? 医生-病房关联解除成功\n");
+        } else {
+            printf("\n操作已取消\n");
+        }
+        
+        waitForEnter();
+        return;
+    }
+    
+    printf("\n? 未找到医生ID %d 和病房号 %d 的关联记录\n", doctorID, wardNumber);
+    waitForEnter();
+}
+
+// 查询医生负责的所有病房
+void listWardsByDoctor() {
+    printOperationTitle("查询医生负责的病房");
+    
+    int doctorID;
+    printf("输入医生ID: ");
+    scanf("%d", &doctorID);
+    flushStdin();
+    
+    // 检查医生是否存在
+    if (!doctorExists(doctorID)) {
+        printf("\n? 错误：医生ID %d 不存在\n", doctorID);
+        waitForEnter();
+        return;
+    }
+    
+    // 显示医生基本信息
+    printf("\n医生信息：\n");
+    printSeparator();
+    printDoctorBasicInfo(findDoctorByID(doctorID));
+    printf("\n");
+    printSeparator();
+    
+    // 显示该医生负责的病房列表
+    printf("\n该医生负责的病房列表：\n");
+    printSeparator();
+    
+    int count = 0;
+    int degree;
+    void** edges = adjacencyEdges(&doctorWardByDoctor, doctorID, &degree);
+    
+    for (int i = 0; i < degree; i++) {
+        struct DoctorWardRelation* relation = (struct DoctorWardRelation*)edges[i];
+        printf("病房号: %d | 主治医生: %s | 查房安排: %s\n", 
+               relation->wardNumber, 
+               relation->isHeadDoctor ? "是" : "否", 
+               relation->scheduleInfo);
+        
+        // 显示该病房中的床位数量
+        int bedCount = 0;
+        int occupiedCount = 0;
+        struct WardIndex* ward = findWardIndex(relation->wardNumber);
+        if (ward != NULL) {
+            bedCount = ward->counter.total;
+            occupiedCount = ward->counter.occupied;
+        }
+        
+        printf("该病房床位情况: 总床位数: %d | 已占用: %d | 空闲: %d\n", 
+               bedCount, occupiedCount, bedCount - occupiedCount);
+        printf("----------------------------------------------------------------\n");
+        count++;
+    }
+    
+    if (count == 0) {
+        printf("该医生暂无负责的病房\n");
+    } else {
+        printf("\n? 共找到 %d 条病房记录\n", count);
+    }
+    
+    waitForEnter();
+}
+
+// 查询病房的所有医生
+void listDoctorsByWard() {
+    printOperationTitle("查询病房的医生");
+    
+    int wardNumber;
+    printf("输入病房号: ");
+    scanf("%d", &wardNumber);
+    flushStdin();
+    
+    // 检查病房是否存在
+    if (!wardExists(wardNumber)) {
+        printf("\n? 错误：病房号 %d 不存在\n", wardNumber);
+        waitForEnter();
+        return;
+    }
+    
+    // 显示病房基本信息
+    int bedCount = 0;
+    int occupiedCount = 0;
+    int department = 0;
+    struct WardIndex* ward = findWardIndex(wardNumber);
+    int words = bedBitmapWords();
+    bedCount = ward->counter.total;
+    occupiedCount = ward->counter.occupied;
+    for (int w = 0; w < words; w++) {
+        if (ward->members[w]) {
+            int i = w * 64 + lowestBit64(ward->members[w]);
+            department = bedColumns.record[i]->department; // 假设同一病房的科室相同
+            break;
+        }
+    }
+    
+    printf("\n病房信息：\n");
+    printSeparator();
+    printf("病房号: %d | 科室: ", wardNumber);
+    printDepartment(department);
+    printf(" | 总床位数: %d | 已占用: %d | 空闲: %d\n", 
+           bedCount, occupiedCount, bedCount - occupiedCount);
+    printSeparator();
+    
+    // 显示负责该病房的医生列表
+    printf("\n负责该病房的医生列表：\n");
+    printSeparator();
+    
+    int count = 0;
+    int degree;
+    void** edges = adjacencyEdges(&doctorWardByWard, wardNumber, &degree);
+    
+    for (int i = 0; i < degree; i++) {
+        struct DoctorWardRelation* relation = (struct DoctorWardRelation*)edges[i];
+        // 查找医生详细信息
+        struct Doctor* doctor = findDoctorByID(relation->doctorID);
+        if (doctor != NULL) {
+            printDoctorBasicInfo(doctor);
+            printf("\n主治医生: %s | 查房安排: %s\n",
+                   relation->isHeadDoctor ? "是" : "否", 
+                   relation->scheduleInfo);
+            printf("----------------------------------------------------------------\n");
+            count++;
+        } else {
+            // 如果找不到该医生信息，只显示关联信息
+            printf("医生ID: %d | 主治医生: %s | 查房安排: %s\n",
+                   relation->doctorID, 
+                   relation->isHeadDoctor ? "是" : "否", 
+                   relation->scheduleInfo);
+            printf("(注: 未找到该医生的详细信息)\n");
+            printf("----------------------------------------------------------------\n");
+            count++;
+        }
+    }
+    
+    if (count == 0) {
+        printf("该病房暂无负责的医生\n");
+    } else {
+        printf("\n? 共找到 %d 条医生记录\n", count);
+    }
+    
+    waitForEnter();
+}
+
+// 从CSV文件加载全部数据: 各文件 (较大的床位文件分成多块) 由线程池并行解析, 再按依赖顺序逐表合并
+void loadTablesFromFiles() {
+    void (*const mergers[TABLE_COUNT])(struct LoadTask*, int) = {
+        loadBedsMerge, loadPatientsMerge, loadDoctorsMerge, loadDoctorPatientMerge, loadDoctorWardMerge
+    };
+    double startTime = nowSeconds();
+    int threads = cpuCount();
+    if (threads > WORKER_MAX_THREADS) {
+        threads = WORKER_MAX_THREADS;
+    }
+    struct LoadTask* tasks = (struct LoadTask*)malloc((threads + TABLE_COUNT - 1) * sizeof(struct LoadTask));
+    if (tasks == NULL) {
+        printf("内存分配失败，无法加载数据\n");
+        return;
+    }
+    // 各表的任务在数组中连续存放, 床位文件的块在最前面, 先被领取
+    int first[TABLE_COUNT];
+    int counts[TABLE_COUNT];
+    int taskCount = 0;
+    for (int t = 0; t < TABLE_COUNT; t++) {
+        first[t] = taskCount;
+        if (t == TableBeds) {
+            counts[t] = loadSplitFile(t, threads, &tasks[taskCount]);
+        } else {
+            loadTaskInit(&tasks[taskCount], t, 0, -1);
+            counts[t] = 1;
+        }
+        taskCount += counts[t];
+    }
+    runParallel(loadTaskRun, tasks, sizeof(struct LoadTask), taskCount, threads);
+
+    for (int t = 0; t < TABLE_COUNT; t++) {
+        mergers[t](&tasks[first[t]], counts[t]);
+    }
+    for (int i = 0; i < taskCount; i++) {
+        loadTaskFree(&tasks[i]);
+    }
+    free(tasks);
+    printf("数据加载完成: %d 个线程，共耗时 %.3f 秒\n", threads < taskCount ? threads : taskCount,
+           nowSeconds() - startTime);
+}
+
+// 检查点: 持有存储锁复制各表 (只在内存中复制), 不持有锁写入CSV、床位检查点文件和快照 (均经临时文件原子替换),
+// 再不持有锁复制操作日志中检查点之后的记录, 最后持有锁登记结果并替换操作日志. 运行期间由后台线程定期执行, 退出时在主线程执行
+#define CHECKPOINT_INTERVAL 300     // 后台检查点的间隔 (秒)
+
+// 为表副本分配count条记录的空间, 失败返回0
+int tableCopyAlloc(struct TableCopy* copy, int count, size_t recordSize) {
+    copy->records = malloc((size_t)(count > 0 ? count : 1) * recordSize);
+    copy->count = count;
+    return copy->records != NULL;
+}
+
+// 复制需要保存的数据 (调用者持有存储锁; 主线程释放存储锁前已提交日志, 日志缓冲区为空).
+// 后台检查点在上次检查点后没有修改时返回0, 内存不足时也返回0
+int checkpointCapture(struct Checkpoint* cp, int quiet) {
+    memset(cp, 0, sizeof(*cp));
+    cp->quiet = quiet;
+    int modified = journal.written > (long long)sizeof(struct JournalFileHeader);
+    for (int t = 0; t < TABLE_COUNT; t++) {
+        cp->generation[t] = tableGeneration[t];
+        cp->save[t] = tableGeneration[t] != tableSavedGeneration[t] || fileModifiedTime(tableFiles[t]) < 0;
+        modified |= cp->save[t];
+    }
+    if (quiet && !modified) {
+        return 0;
+    }
+    // 内存不足时未能记录脏页, 须整体重写床位检查点文件
+    cp->live = bedFileLive.data != NULL;
+    cp->bedCheckpoint = bedFile.pagesLost ? 0 : bedFile.checkpoint;
+    cp->bedCapacity = bedFile.capacity;
+    int dirtyPages = 0;
+    for (int w = 0; w < bedFile.dirtyWords; w++) {
+        dirtyPages |= bedFile.dirtyPages[w] != 0;
+    }
+    int copyBeds = cp->save[TableBeds] ||
+                   (!cp->live && (dirtyPages || cp->bedCheckpoint == 0 || bedColumns.count > cp->bedCapacity));
+
+    int patients = 0, doctors = 0, doctorPatients = 0, doctorWards = 0;
+    for (struct PatientRecord* patient = patientHead; patient != NULL; patient = patient->next) {
+        patients += patient->bed == NULL;
+    }
+    for (struct Doctor* doctor = doctorHead; doctor != NULL; doctor = doctor->next) {
+        doctors++;
+    }
+    for (struct DoctorPatientRelation* relation = doctorPatientHead; relation != NULL; relation = relation->next) {
+        doctorPatients++;
+    }
+    for (struct DoctorWardRelation* relation = doctorWardHead; relation != NULL; relation = relation->next) {
+        doctorWards++;
+    }
+    struct TableCopy* beds = &cp->tables[TableBeds];
+    int ok = tableCopyAlloc(&cp->tables[TablePatients], patients, sizeof(struct SnapshotPatient)) &&
+             tableCopyAlloc(&cp->tables[TableDoctors], doctors, sizeof(struct SnapshotDoctor)) &&
+             tableCopyAlloc(&cp->tables[TableDoctorPatient], doctorPatients, sizeof(struct SnapshotDoctorPatient)) &&
+             tableCopyAlloc(&cp->tables[TableDoctorWard], doctorWards, sizeof(struct SnapshotDoctorWard));
+    if (ok && copyBeds) {
+        ok = tableCopyAlloc(beds, bedColumns.count, sizeof(struct SnapshotBed)) &&
+             (beds->order = (int*)malloc((size_t)(bedColumns.count + 1) * sizeof(int))) != NULL &&
+             (cp->live || (cp->dirtyPages = (unsigned long long*)calloc(bedFile.dirtyWords + 1, sizeof(unsigned long long))) != NULL);
+    }
+    if (!ok) {
+        printf("警告: 内存不足，无法保存检查点\n");
+        return 0;
+    }
+
+    // 床位按槽位顺序复制 (与床位检查点文件一致), 另记链表顺序供CSV使用
+    if (copyBeds) {
+        struct SnapshotBed* records = (struct SnapshotBed*)beds->records;
+        for (int i = 0; i < bedColumns.count; i++) {
+            snapshotFromBed(&records[i], bedColumns.record[i]);
+        }
+        int n = 0;
+        for (struct Bed* bed = head; bed != NULL; bed = bed->next) {
+            beds->order[n++] = bed->slot;
+        }
+        // 取走脏页标记, 之后的修改记入新的标记 (实时模式下脏页由每次提交写入)
+        if (!cp->live) {
+            cp->dirtyWords = bedFile.dirtyWords;
+            if (bedFile.dirtyWords > 0) {
+                memcpy(cp->dirtyPages, bedFile.dirtyPages, bedFile.dirtyWords * sizeof(unsigned long long));
+                memset(bedFile.dirtyPages, 0, bedFile.dirtyWords * sizeof(unsigned long long));
+            }
+            bedFile.pagesLost = 0;
+        }
+    }
+    struct SnapshotPatient* patientRecords = (struct SnapshotPatient*)cp->tables[TablePatients].records;
+    for (struct PatientRecord* patient = patientHead; patient != NULL; patient = patient->next) {
+        if (patient->bed == NULL) {
+            snapshotFromPatient(patientRecords++, patient);
+        }
+    }
+    struct SnapshotDoctor* doctorRecords = (struct SnapshotDoctor*)cp->tables[TableDoctors].records;
+    for (struct Doctor* doctor = doctorHead; doctor != NULL; doctor = doctor->next) {
+        snapshotFromDoctor(doctorRecords++, doctor);
+    }
+    struct SnapshotDoctorPatient* doctorPatientRecords = (struct SnapshotDoctorPatient*)cp->tables[TableDoctorPatient].records;
+    for (struct DoctorPatientRelation* relation = doctorPatientHead; relation != NULL; relation = relation->next) {
+        snapshotFromDoctorPatient(doctorPatientRecords++, relation);
+    }
+    struct SnapshotDoctorWard* doctorWardRecords = (struct SnapshotDoctorWard*)cp->tables[TableDoctorWard].records;
+    for (struct DoctorWardRelation* relation = doctorWardHead; relation != NULL; relation = relation->next) {
+        snapshotFromDoctorWard(doctorWardRecords++, relation);
+    }
+    cp->journalOffset = journal.written;
+    return 1;
+}
+
+// 从副本写入文件 (不访问存储, 可在后台线程执行): 只重写被修改过的CSV文件, 再保存床位检查点文件和快照
+void checkpointWrite(struct Checkpoint* cp) {
+    int (*const savers[TABLE_COUNT])(const char*, const struct TableCopy*) = {
+        saveBedsToFile, savePatientsToFile, saveDoctorsToFile, saveDoctorPatientToFile, saveDoctorWardToFile
+    };
+    static const char* const savedMessages[TABLE_COUNT] = {
+        "\n? 床位信息保存成功！共保存 %d 条记录到CSV文件\n",
+        "\n? 病人登记信息保存成功！共保存 %d 条未分配床位的病人记录\n",
+        "\n? 医生信息保存成功！共保存 %d 条记录到CSV文件\n",
+        "\n? 医生-病人关联数据保存成功！共保存 %d 条记录到CSV文件\n",
+        "\n? 医生-病房关联数据保存成功！共保存 %d 条记录到CSV文件\n"
+    };
+    int saved = 1;
+    for (int t = 0; t < TABLE_COUNT; t++) {
+        if (!cp->save[t]) {
+            if (!cp->quiet) {
+                printf("\n%s 未修改，无需保存\n", tableFiles[t]);
+            }
+            continue;
+        }
+        int count = savers[t](tableFiles[t], &cp->tables[t]);
+        cp->saved[t] = count >= 0;
+        if (count >= 0 && !cp->quiet) {
+            printf(savedMessages[t], count);
+        }
+        saved = saved && cp->saved[t];
+    }
+    // 快照在CSV之后写入, 下次启动时快照不早于CSV
+    cp->complete = saved && (cp->live || cp->tables[TableBeds].records == NULL || saveBedFile(BED_FILE, cp)) &&
+                   saveSnapshot(SNAPSHOT_FILE, cp);
+}
+
+// 登记写入结果 (调用者持有存储锁). 有CSV保存失败时不更新快照, 下次启动从CSV加载并重放完整的操作日志
+void checkpointFinish(struct Checkpoint* cp, struct JournalCompaction* compaction) {
+    for (int t = 0; t < TABLE_COUNT; t++) {
+        if (cp->saved[t]) {
+            tableSavedGeneration[t] = cp->generation[t];
+        }
+    }
+    if (!cp->live && cp->tables[TableBeds].records != NULL) {
+        // 未能写入时文件可能已部分修改, 复制时取走的脏页也已丢失, 下次整体重写
+        bedFile.checkpoint = cp->bedSaved ? cp->newBedCheckpoint : 0;
+        if (cp->bedSaved) {
+            bedFile.capacity = cp->newBedCapacity;
+        }
+    }
+    if (cp->complete) {
+        journalCompactFinish(compaction, cp->generation);
+    }
+}
+
+void checkpointFree(struct Checkpoint* cp) {
+    for (int t = 0; t < TABLE_COUNT; t++) {
+        free(cp->tables[t].records);
+        free(cp->tables[t].order);
+    }
+    free(cp->dirtyPages);
+}
+
+// 执行一次检查点, 写入文件和复制日志期间不持有存储锁, 菜单操作不会等待磁盘写入; 完整保存时返回1
+int checkpointRun(int quiet) {
+    struct Checkpoint cp;
+    mutexLock(&storeMutex);
+    int captured = checkpointCapture(&cp, quiet);
+    mutexUnlock(&storeMutex);
+    if (captured) {
+        checkpointWrite(&cp);
+        struct JournalCompaction compaction;
+        int usable = 0;
+        long long end = 0;
+        if (cp.complete) {
+            mutexLock(&storeMutex);
+            usable = journal.file != NULL && !journal.failed;
+            end = journal.written;
+            mutexUnlock(&storeMutex);
+        }
+        if (usable) {
+            journalCompactBegin(&compaction, cp.journalOffset, end);
+        }
+        mutexLock(&storeMutex);
+        checkpointFinish(&cp, usable ? &compaction : NULL);
+        mutexUnlock(&storeMutex);
+    }
+    checkpointFree(&cp);
+    return captured && cp.complete;
+}
+
+// 后台检查点线程: 每隔CHECKPOINT_INTERVAL秒执行一次检查点, 退出时被唤醒
+struct CheckpointThread {
+    int started;
+#ifdef _WIN32
+    HANDLE thread;
+    HANDLE wake;                // 退出时置位
+#else
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int stopping;
+#endif
+};
+
+struct CheckpointThread checkpointThread;
+
+#ifdef _WIN32
+DWORD WINAPI checkpointThreadMain(LPVOID unused) {
+    (void)unused;
+    while (WaitForSingleObject(checkpointThread.wake, CHECKPOINT_INTERVAL * 1000) == WAIT_TIMEOUT) {
+        checkpointRun(1);
+    }
+    return 0;
+}
+#else
+void* checkpointThreadMain(void* unused) {
+    (void)unused;
+    pthread_mutex_lock(&checkpointThread.lock);
+    while (!checkpointThread.stopping) {
+        struct timespec deadline;
+        timespec_get(&deadline, TIME_UTC);
+        deadline.tv_sec += CHECKPOINT_INTERVAL;
+        if (pthread_cond_timedwait(&checkpointThread.wake, &checkpointThread.lock, &deadline) == ETIMEDOUT &&
+            !checkpointThread.stopping) {
+            pthread_mutex_unlock(&checkpointThread.lock);
+            checkpointRun(1);
+            pthread_mutex_lock(&checkpointThread.lock);
+        }
+    }
+    pthread_mutex_unlock(&checkpointThread.lock);
+    return NULL;
+}
+#endif
+
+void checkpointThreadStart() {
+#ifdef _WIN32
+    checkpointThread.wake = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (checkpointThread.wake != NULL) {
+        checkpointThread.thread = CreateThread(NULL, 0, checkpointThreadMain, NULL, 0, NULL);
+        checkpointThread.started = checkpointThread.thread != NULL;
+        if (!checkpointThread.started) {
+            CloseHandle(checkpointThread.wake);
+        }
+    }
+#else
+    pthread_mutex_init(&checkpointThread.lock, NULL);
+    pthread_cond_init(&checkpointThread.wake, NULL);
+    checkpointThread.stopping = 0;
+    checkpointThread.started = pthread_create(&checkpointThread.thread, NULL, checkpointThreadMain, NULL) == 0;
+    if (!checkpointThread.started) {
+        pthread_cond_destroy(&checkpointThread.wake);
+        pthread_mutex_destroy(&checkpointThread.lock);
+    }
+#endif
+    if (!checkpointThread.started) {
+        printf("警告: 无法启动后台检查点线程，数据只在退出时保存\n");
+    }
+}
+
+// 停止后台检查点线程, 正在进行的检查点会先完成 (调用者不能持有存储锁)
+void checkpointThreadStop() {
+    if (!checkpointThread.started) {
+        return;
+    }
+#ifdef _WIN32
+    SetEvent(checkpointThread.wake);
+    WaitForSingleObject(checkpointThread.thread, INFINITE);
+    CloseHandle(checkpointThread.thread);
+    CloseHandle(checkpointThread.wake);
+#else
+    pthread_mutex_lock(&checkpointThread.lock);
+    checkpointThread.stopping = 1;
+    pthread_cond_signal(&checkpointThread.wake);
+    pthread_mutex_unlock(&checkpointThread.lock);
+    pthread_join(checkpointThread.thread, NULL);
+    pthread_cond_destroy(&checkpointThread.wake);
+    pthread_mutex_destroy(&checkpointThread.lock);
+#endif
+    checkpointThread.started = 0;
+}
+
+// 退出时保存全部数据; 未能完整保存时保留操作日志, 下次启动时重放
+void saveCheckpoint() {
+    int complete = checkpointRun(0);
+    journalClose();
+    bedFileLiveClose(complete);
+}
+
+int main() {
+    int choice;
+    
+    cpuHasAvx2 = detectAvx2();
+    mutexInit(&storeMutex);
+    
+    // 快照不早于CSV文件时直接映射快照加载, 否则从CSV文件导入
+    if (!snapshotIsCurrent(SNAPSHOT_FILE, tableFiles, TABLE_COUNT) || !loadSnapshot(SNAPSHOT_FILE)) {
+        loadTablesFromFiles();
+    }
+    // 重放上次未正常退出时留下的操作日志, 之后的修改开始记录
+    journalReplay();
+    
+    // 病人表完整加载时归档病人已不存在的医生-病人关联 (记入日志, 检查点时从CSV中移除)
+    if (patientTableComplete) {
+        int archived = archiveOrphanRelations();
+        if (archived > 0) {
+            printf("%d 条医生-病人关联的病人已不存在，已归档到 %s\n", archived, DOCTOR_PATIENT_ARCHIVE);
+        }
+    } else {
+        printf("病人数据未完整加载，暂不清理医生-病人关联\n");
+    }
+    
+    // 数据文件可能在程序外被修改, 启动时为能找到床位的候床病人分配床位
+    int matched = waitlistMatchAll();
+    if (matched > 0) {
+        printf("已为 %d 名候床病人自动分配床位\n", matched);
+    }
+    journalCommit();
+    if (LIVE_BED_FILE && journal.file != NULL && !journal.failed && !bedFileLiveOpen()) {
+        printf("警告: 无法进入实时模式，床位修改只在检查点保存\n");
+    }
+    checkpointThreadStart();
+    
+    // 主循环
+    while (1) {
+        // 显示菜单
+        printMenu();
+        
+        // 获取用户选择
+        if (scanf("%d", &choice) != 1) {
+            printf("? 无效的输入，请输入数字选项\n");
+            flushStdin();
+            printf("\n按回车键继续...");
+            getchar();
+            continue;
+        }
+        flushStdin(); // 清空输入缓冲区
+        
+        // 处理用户选择 (各操作读完输入后才持有存储锁修改数据, 后台检查点在修改之间复制数据)
+        switch (choice) {
+        case 1:
+            registerPatient();
+            break;
+        case 2:
+            assignBed();
+            break;
+        case 3:
+            dischargePatient();
+            break;
+        case 4:
+            addBed();
+            break;
+        case 5:
+            modifyBed();
+            break;
+        case 6:
+            deleteBed();
+            break;
+        case 7:
+            searchBedByID();
+            break;
+        case 8:
+            listAllBeds();
+            break;
+        case 9:
+            listAvailableBeds();
+            break;
+        case 10:
+            filterBedsByType();
+            break;
+        case 11:
+            filterBedsByWard();
+            break;
+        case 12:
+            filterBedsByDepartment();
+            break;
+        case 13:
+            sortBedsByID();
+            break;
+        case 14:
+            addDoctor();
+            break;
+        case 15:
+            modifyDoctor();
+            break;
+        case 16:
+            deleteDoctor();
+            break;
+        case 17:
+            searchDoctorByID();
+            break;
+        case 18:
+            listAllDoctors();
+            break;
+        case 19:
+            assignPatientToDoctor();
+            break;
+        case 20:
+            assignWardToDoctor();
+            break;
+        case 21:
+            listPatientsByDoctor();
+            break;
+        case 22:
+            listWardsByDoctor();
+            break;
+        case 25:
+            filterBedsCombined();
+            break;
+        case 26:
+            showBedSummary();
+            break;
+        case 27:
+            listBedsByIDRange();
+            break;
+        case 28:
+            searchPatientByID();
+            break;
+        case 29:
+            listWaitlist();
+            break;
+        case 30:
+            searchPatientsByText();
+            break;
+        case 31:
+            searchByPhone();
+            break;
+        case 24:
+            checkpointThreadStop();
+            saveCheckpoint();
+            printf("感谢使用医院床位管理系统，再见！\n");
+            cleanupMemory();
+            exit(0);
+        default:
+            printf("? 无效的选项，请输入有效的菜单选项\n");
+            printf("\n按回车键继续...");
+            getchar();
+            break;
+        }
+        storeCommit();      // 组提交: 本次操作的所有记录只刷盘一次
+    }
+    
+    return 0;
 } 
\ No newline at end of file